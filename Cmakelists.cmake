@@ -27,3 +27,30 @@ target_include_directories(execue PRIVATE src/)
 
 # Definitions
 add_definitions(-DEXECUE_VERSION=\"${EXECUE_VERSION}\")
+
+# Standalone programs the EXECUE_* options below apply to: the DominionVM
+# compiler (ExecueCompiler.cpp) and the instruction dispatch benchmark.
+find_package(Threads REQUIRED)
+
+add_executable(execue_compiler ExecueCompiler.cpp)
+target_link_libraries(execue_compiler PRIVATE Threads::Threads)
+
+add_executable(instruction_bench ExecueInstructionBench.cpp)
+
+# DominionVM dispatcher: computed-goto threading by default on GCC/Clang
+option(EXECUE_DISPATCH_SWITCH "Use the portable switch dispatcher in DominionVM" OFF)
+if (EXECUE_DISPATCH_SWITCH)
+    add_definitions(-DEXECUE_DISPATCH_SWITCH)
+endif()
+
+# DominionVM native backend (x86-64 Linux only)
+option(EXECUE_NO_JIT "Leave the DominionVM x86-64 JIT out of the build" OFF)
+if (EXECUE_NO_JIT)
+    add_definitions(-DEXECUE_NO_JIT)
+endif()
+
+# Per-opcode profiling in InstructionSet::execute (counts, cycles, jumps)
+option(EXECUE_PROFILE "Compile the InstructionSet opcode profiler in" OFF)
+if (EXECUE_PROFILE)
+    add_definitions(-DEXECUE_PROFILE=1)
+endif()
@@ -5,11 +5,14 @@
 #include <functional>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdint>
+
+#include "src/memory/access_policy.h"
 
 // Forward declarations for structs and classes
 class Opcode;
 class DominionStack;
-class MemoryBank;
+template <typename AccessPolicy> class MemoryBank;
 class ExecEngine;
 class FrameBuffer;
 class ErrorLogger;
@@ -38,7 +41,9 @@ public:
         : name(name), execute(execute) {}
 };
 
-// Class representing memory bank
+// Class representing memory bank. Bounds handling comes from the access
+// policy (src/memory/access_policy.h); the default throws like it always has.
+template <typename AccessPolicy = execue::CheckedAccess>
 class MemoryBank {
 public:
     std::vector<uint8_t> memory;
@@ -46,18 +51,27 @@ public:
     MemoryBank() : memory(MAX_MEMORY_SIZE, 0) {}
 
     void write(uint32_t address, uint8_t value) {
-        if (address >= MAX_MEMORY_SIZE) {
-            throw std::out_of_range("Memory address out of bounds");
+        if (AccessPolicy::admit(address, MAX_MEMORY_SIZE, fault)) {
+            memory[address] = value;
         }
-        memory[address] = value;
     }
 
     uint8_t read(uint32_t address) {
-        if (address >= MAX_MEMORY_SIZE) {
-            throw std::out_of_range("Memory address out of bounds");
-        }
-        return memory[address];
+        return AccessPolicy::admit(address, MAX_MEMORY_SIZE, fault) ? memory[address] : 0;
+    }
+
+    // ERR_MEMORY_OVERFLOW once a refused access was recorded (error-register
+    // policy only), ERR_NONE otherwise.
+    ErrorCode errorRegister() const {
+        return fault ? ERR_MEMORY_OVERFLOW : ERR_NONE;
+    }
+
+    void clearError() {
+        fault = false;
     }
+
+private:
+    bool fault = false;
 };
 
 // Class representing the Dominion Stack
@@ -91,11 +105,19 @@ public:
     void executeInstruction(const Instruction& instruction);
 };
 
+// ErrorLogger class to manage and log errors
+class ErrorLogger {
+public:
+    void logError(ErrorCode code, const std::string& message) {
+        std::cerr << "Error [" << code << "]: " << message << std::endl;
+    }
+};
+
 // Class for managing and executing a set of instructions (the core of the EXECUE engine)
 class ExecEngine {
 public:
     DominionStack stack;
-    MemoryBank memory;
+    MemoryBank<> memory;
     ErrorLogger* logger;
     std::vector<Opcode> opcodes;
 
@@ -116,14 +138,6 @@ public:
     }
 };
 
-// ErrorLogger class to manage and log errors
-class ErrorLogger {
-public:
-    void logError(ErrorCode code, const std::string& message) {
-        std::cerr << "Error [" << code << "]: " << message << std::endl;
-    }
-};
-
 // Class for managing and running instructions
 class Instruction {
 public:
@@ -133,7 +147,7 @@ public:
     Instruction(const std::string& name, const std::vector<std::string>& operands)
         : instructionName(name), operands(operands) {}
 
-    void execute(ExecEngine& engine) {
+    void execute(ExecEngine& engine) const {
         // Interpret and execute the instruction
         if (instructionName == "ADD") {
             uint32_t op1 = std::stoi(operands[0]);
@@ -195,7 +209,7 @@ int main() {
     Instruction subInst("SUB", {"10", "4"});
 
     // Execute instructions
-    Engine.execute();
+    engine.execute();
 
     // Optimizing the code (dead code removal, etc.)
     std::vector<Instruction> instructions = {addInst, subInst};
@@ -6,11 +6,52 @@
 #include <sstream>
 #include <vector>
 #include <map>
+#include <unordered_map>
+#include <type_traits>
 #include <filesystem>
 #include <functional>
 #include <stdexcept>
 #include <thread>
 #include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <memory>
+#include <cstddef>
+#include <initializer_list>
+#include <array>
+#include <charconv>
+#include <system_error>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "src/io/output_sink.h"
+#include "src/runtime/cancellation.h"
+
+// Dispatcher selection: computed-goto threading on GCC/Clang, a switch elsewhere.
+// Build with -DEXECUE_DISPATCH_SWITCH to force the portable switch dispatcher.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(EXECUE_DISPATCH_SWITCH)
+#define EXECUE_THREADED_DISPATCH 1
+#else
+#define EXECUE_THREADED_DISPATCH 0
+#endif
+
+// The native backend targets x86-64 Linux. Build with -DEXECUE_NO_JIT to leave it out.
+#if defined(__x86_64__) && defined(__linux__) && !defined(EXECUE_NO_JIT)
+#define EXECUE_JIT 1
+#else
+#define EXECUE_JIT 0
+#endif
 
 namespace ExecueCore {
     using namespace std;
@@ -24,90 +65,1950 @@ namespace ExecueCore {
         int operand;
     };
 
+    // Handler indices for the pre-decoded stream. The first nine mirror Opcode; END is
+    // the sentinel appended after the last instruction and the target of every jump
+    // that leaves the program. The superinstructions after it are produced by
+    // fuseSuperinstructions; those spanning two slots keep their second operand in a
+    // trailing OPERAND slot, which is never dispatched.
+    enum class Handler : uint32_t {
+        NOP, LOAD, STORE, ADD, SUB, JMP, JZ, PRINT, HALT, END,
+        LOAD_ADD_STORE,     // LOAD n; ADD|SUB k; STORE a   -> operand n+k, then a
+        DEC_JZ,             // SUB 1; JZ t                  -> operand t
+        DEC_JZ_JMP,         // SUB 1; JZ t; JMP l           -> operand t, then l
+        OPERAND
+    };
+
+    struct DecodedOp {
+        Handler handler;
+        int32_t operand;
+    };
+
+    // Lowers a parsed program into the handler stream DominionVM executes. Jump
+    // operands are resolved to stream indices, clamped to the END sentinel.
+    inline vector<DecodedOp> decodeProgram(const vector<Instruction>& program) {
+        const auto end = static_cast<int32_t>(program.size());
+        vector<DecodedOp> code;
+        code.reserve(program.size() + 1);
+        for (const auto& instr : program) {
+            DecodedOp op{ static_cast<Handler>(instr.opcode), instr.operand };
+            if ((instr.opcode == Opcode::JMP || instr.opcode == Opcode::JZ)
+                && (op.operand < 0 || op.operand > end)) {
+                op.operand = end;
+            }
+            code.push_back(op);
+        }
+        code.push_back({ Handler::END, 0 });
+        return code;
+    }
+
+    // Static hit counts for each superinstruction pattern.
+    struct FusionStats {
+        uint32_t load_add_store = 0;
+        uint32_t dec_jz = 0;
+        uint32_t dec_jz_jmp = 0;
+    };
+
+    // Dynamic counts: how many times each superinstruction ran, whether it was
+    // dispatched or replayed as part of a trace.
+    struct FusionCounts {
+        uint64_t load_add_store = 0;
+        uint64_t dec_jz = 0;
+        uint64_t dec_jz_jmp = 0;
+
+        void add(const FusionCounts& other, uint64_t times = 1) {
+            load_add_store += other.load_add_store * times;
+            dec_jz += other.dec_jz * times;
+            dec_jz_jmp += other.dec_jz_jmp * times;
+        }
+    };
+
+    // Load-time peephole pass over a decoded stream. A sequence is only fused when
+    // no jump lands inside it; every jump operand is remapped to the new stream.
+    inline vector<DecodedOp> fuseSuperinstructions(const vector<DecodedOp>& code, FusionStats& stats) {
+        const size_t n = code.size();
+        vector<bool> target(n, false);
+        for (const auto& op : code) {
+            if (op.handler == Handler::JMP || op.handler == Handler::JZ) target[op.operand] = true;
+        }
+        const auto is = [&](size_t i, Handler handler) {
+            return i < n && code[i].handler == handler && !target[i];
+        };
+
+        vector<int32_t> remap(n);
+        vector<DecodedOp> fused;
+        fused.reserve(n);
+        for (size_t i = 0; i < n;) {
+            remap[i] = static_cast<int32_t>(fused.size());
+            const DecodedOp& op = code[i];
+            if (op.handler == Handler::LOAD && (is(i + 1, Handler::ADD) || is(i + 1, Handler::SUB))
+                && is(i + 2, Handler::STORE)) {
+                // Fold in unsigned arithmetic so the constant wraps like the accumulator.
+                const uint32_t k = static_cast<uint32_t>(code[i + 1].operand);
+                const uint32_t value = static_cast<uint32_t>(op.operand)
+                    + (code[i + 1].handler == Handler::ADD ? k : 0u - k);
+                fused.push_back({ Handler::LOAD_ADD_STORE, static_cast<int32_t>(value) });
+                fused.push_back({ Handler::OPERAND, code[i + 2].operand });
+                ++stats.load_add_store;
+                i += 3;
+            } else if (op.handler == Handler::SUB && op.operand == 1 && is(i + 1, Handler::JZ)) {
+                if (is(i + 2, Handler::JMP)) {
+                    fused.push_back({ Handler::DEC_JZ_JMP, code[i + 1].operand });
+                    fused.push_back({ Handler::OPERAND, code[i + 2].operand });
+                    ++stats.dec_jz_jmp;
+                    i += 3;
+                } else {
+                    fused.push_back({ Handler::DEC_JZ, code[i + 1].operand });
+                    ++stats.dec_jz;
+                    i += 2;
+                }
+            } else {
+                fused.push_back(op);
+                ++i;
+            }
+        }
+
+        for (size_t j = 0; j < fused.size(); ++j) {
+            switch (fused[j].handler) {
+                case Handler::JMP: case Handler::JZ: case Handler::DEC_JZ:
+                    fused[j].operand = remap[fused[j].operand];
+                    break;
+                case Handler::DEC_JZ_JMP:
+                    fused[j].operand = remap[fused[j].operand];
+                    fused[j + 1].operand = remap[fused[j + 1].operand];
+                    break;
+                default:
+                    break;
+            }
+        }
+        return fused;
+    }
+
+    struct DecodeOptions {
+        bool fuse = true;
+    };
+
+    // An immutable decoded program: the handler stream plus the address range its
+    // STORE/PRINT operands span. The stream is either owned or a view into a mapped
+    // .exb file; `storage` keeps whichever backs it alive.
+    struct DecodedProgram {
+        const DecodedOp* ops = nullptr;
+        size_t size = 0;                        // including the END sentinel
+        int lowestAddress = 0;
+        int highestAddress = 0;
+        FusionStats fusion;
+        shared_ptr<const void> storage;
+
+        static shared_ptr<const DecodedProgram> fromInstructions(const vector<Instruction>& program,
+                                                                 const DecodeOptions& options = {}) {
+            auto code = make_shared<vector<DecodedOp>>(decodeProgram(program));
+            auto decoded = make_shared<DecodedProgram>();
+            for (const auto& op : *code) {
+                if (op.handler == Handler::STORE || op.handler == Handler::PRINT) {
+                    decoded->lowestAddress = min(decoded->lowestAddress, op.operand);
+                    decoded->highestAddress = max(decoded->highestAddress, op.operand);
+                }
+            }
+            if (options.fuse) *code = fuseSuperinstructions(*code, decoded->fusion);
+            decoded->ops = code->data();
+            decoded->size = code->size();
+            decoded->storage = move(code);
+            return decoded;
+        }
+
+        static const shared_ptr<const DecodedProgram>& empty() {
+            static const DecodedOp end{ Handler::END, 0 };
+            static const shared_ptr<const DecodedProgram> program =
+                make_shared<const DecodedProgram>(DecodedProgram{ &end, 1, 0, 0, {}, nullptr });
+            return program;
+        }
+    };
+
+    // Cycle pacing for DominionVM::execute. UNPACED runs as fast as the host allows;
+    // CYCLE holds the VM to one instruction per cycle_time_ns against an absolute
+    // schedule, so time overslept in one slice is paid back in the next.
+    enum class PacingMode {
+        UNPACED, CYCLE
+    };
+
+    struct PacingPolicy {
+        PacingMode mode = PacingMode::UNPACED;
+        uint64_t cycle_time_ns = 2500;          // ExecueSystem::cycle_time_ns default
+        uint64_t instruction_budget = 0;        // 0 = unlimited
+        chrono::nanoseconds time_budget{ 0 };   // 0 = unlimited
+    };
+
+    enum class StopReason {
+        HALTED, END_OF_PROGRAM, INSTRUCTION_BUDGET, TIME_BUDGET, CANCELLED
+    };
+
+    struct RunStats {
+        uint64_t instructions = 0;
+        chrono::nanoseconds elapsed{ 0 };
+        StopReason reason = StopReason::END_OF_PROGRAM;
+    };
+
+    // Memory layout for DominionVM. AUTO picks a flat array sized at load() when every
+    // address the program touches fits under dense_limit, and a sparse map otherwise.
+    enum class MemoryLayout {
+        AUTO, DENSE, SPARSE
+    };
+
+    struct MemoryConfig {
+        MemoryLayout layout = MemoryLayout::AUTO;
+        int dense_limit = 1 << 20;              // cells
+    };
+
+    // Contiguous cell array. Address 0 is the accumulator, which lives in a register,
+    // so its cell is never read.
+    class DenseMemory {
+        vector<int> cells;
+    public:
+        void reset(size_t size) { cells.assign(size, 0); }
+        int& operator[](int address) { return cells[static_cast<size_t>(address)]; }
+        int* data() { return cells.data(); }
+        const vector<int>& contents() const { return cells; }
+    };
+
+    // Fallback for programs that address very large or negative ranges.
+    class SparseMemory {
+        map<int, int> cells;
+    public:
+        void reset(size_t) { cells.clear(); }
+        int& operator[](int address) { return cells[address]; }
+    };
+
+    // Native x86-64 backend for dense-memory programs on Linux. Each decoded op is
+    // lowered to a short machine code sequence in an mmap'd page that is made
+    // executable only after it is written. Register plan: rbx = JitState,
+    // r12 = memory base, r13d = accumulator, r14 = retired instruction count,
+    // r15 = fuel. Fuel is checked on backward jumps only, so a slice can overrun
+    // by at most the straight-line code between two loop back edges.
+    struct JitState {
+        int32_t* memory;
+        void (*print)(JitState*, int32_t);
+        const void* const* entries;             // native address of each decoded op
+        int64_t fuel;
+        int32_t acc;
+        uint32_t pc;
+        uint8_t halted;
+        void* context;
+    };
+
+#if EXECUE_JIT
+    class X64Jit {
+    public:
+        using Entry = uint64_t (*)(JitState*);
+
+        X64Jit(const X64Jit&) = delete;
+        X64Jit& operator=(const X64Jit&) = delete;
+
+        ~X64Jit() {
+            if (region) ::munmap(region, regionSize);
+        }
+
+        // Returns null if the program cannot be compiled (addresses beyond what a
+        // 32-bit displacement reaches, or the pages cannot be mapped).
+        static unique_ptr<X64Jit> compile(const DecodedProgram& program) {
+            if (program.lowestAddress < 0 || program.highestAddress >= (1 << 29)) return nullptr;
+            unique_ptr<X64Jit> jit(new X64Jit());
+            if (!jit->emitProgram(program)) return nullptr;
+            return jit;
+        }
+
+        uint64_t run(JitState& state) const {
+            state.entries = entries.data();
+            return entry(&state);
+        }
+
+    private:
+        X64Jit() = default;
+
+        vector<uint8_t> buffer;
+        vector<size_t> opOffsets;
+        vector<const void*> entries;
+        void* region = nullptr;
+        size_t regionSize = 0;
+        Entry entry = nullptr;
+
+        struct Fixup {
+            size_t at;                          // offset of the rel32 field
+            uint32_t target;                    // decoded op index, stub index or kEpilogue
+            bool stub;
+        };
+        static constexpr uint32_t kEpilogue = UINT32_MAX;
+        vector<Fixup> fixups;
+        vector<pair<size_t, uint32_t>> stubs;   // (offset, resume pc) per budget exit
+
+        static constexpr uint8_t kMemory = offsetof(JitState, memory);
+        static constexpr uint8_t kPrint = offsetof(JitState, print);
+        static constexpr uint8_t kEntries = offsetof(JitState, entries);
+        static constexpr uint8_t kFuel = offsetof(JitState, fuel);
+        static constexpr uint8_t kAcc = offsetof(JitState, acc);
+        static constexpr uint8_t kPc = offsetof(JitState, pc);
+        static constexpr uint8_t kHalted = offsetof(JitState, halted);
+
+        void bytes(initializer_list<uint8_t> list) { buffer.insert(buffer.end(), list); }
+        void imm32(int32_t value) {
+            uint8_t raw[4];
+            memcpy(raw, &value, 4);
+            buffer.insert(buffer.end(), raw, raw + 4);
+        }
+        void countRetired(uint8_t n) { bytes({ 0x49, 0x83, 0xC6, n }); }        // add r14, n
+        void setPc(uint32_t pc) { bytes({ 0xC7, 0x43, kPc }); imm32(static_cast<int32_t>(pc)); }
+        void jumpTo(uint8_t op0, uint8_t op1, uint32_t target, bool stub) {
+            if (op0) bytes({ op0, op1 }); else bytes({ op1 });
+            fixups.push_back({ buffer.size(), target, stub });
+            imm32(0);
+        }
+        void jmp(uint32_t target) { jumpTo(0, 0xE9, target, false); }
+        void jz(uint32_t target) { jumpTo(0x0F, 0x84, target, false); }
+
+        // Taken jump to `target`. Backward jumps leave through a stub once the
+        // retired count reaches the fuel in r15.
+        void branch(uint32_t from, uint32_t target) {
+            if (target <= from) {
+                bytes({ 0x4D, 0x39, 0xFE });                                    // cmp r14, r15
+                stubs.push_back({ 0, target });
+                jumpTo(0x0F, 0x83, static_cast<uint32_t>(stubs.size() - 1), true); // jae stub
+            }
+            jmp(target);
+        }
+
+        // Skips the following taken-branch sequence when the accumulator is non-zero.
+        size_t jnzPlaceholder() {
+            bytes({ 0x0F, 0x85 });
+            imm32(0);
+            return buffer.size();
+        }
+        void patchHere(size_t after) {
+            const int32_t rel = static_cast<int32_t>(buffer.size() - after);
+            memcpy(&buffer[after - 4], &rel, 4);
+        }
+
+        void storeAcc(int32_t address) {                                       // mov [r12+disp32], r13d
+            bytes({ 0x45, 0x89, 0xAC, 0x24 });
+            imm32(address * 4);
+        }
+
+        bool emitProgram(const DecodedProgram& program) {
+            const auto n = static_cast<uint32_t>(program.size);
+            opOffsets.assign(n, 0);
+
+            // Prologue: save callee-saved registers (leaves rsp 16-byte aligned for
+            // the PRINT helper call), load state, jump to the entry for state->pc.
+            bytes({ 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57 });
+            bytes({ 0x48, 0x89, 0xFB });                                        // mov rbx, rdi
+            bytes({ 0x4C, 0x8B, 0x63, kMemory });                               // mov r12, [rbx+memory]
+            bytes({ 0x44, 0x8B, 0x6B, kAcc });                                  // mov r13d, [rbx+acc]
+            bytes({ 0x4C, 0x8B, 0x7B, kFuel });                                 // mov r15, [rbx+fuel]
+            bytes({ 0x45, 0x31, 0xF6 });                                        // xor r14d, r14d
+            bytes({ 0x8B, 0x43, kPc });                                         // mov eax, [rbx+pc]
+            bytes({ 0x48, 0x8B, 0x4B, kEntries });                              // mov rcx, [rbx+entries]
+            bytes({ 0xFF, 0x24, 0xC1 });                                        // jmp [rcx+rax*8]
+
+            size_t epilogue = 0;
+            for (uint32_t i = 0; i < n; ++i) {
+                const DecodedOp& op = program.ops[i];
+                opOffsets[i] = buffer.size();
+                switch (op.handler) {
+                    case Handler::NOP:
+                        countRetired(1);
+                        break;
+                    case Handler::LOAD:
+                        countRetired(1);
+                        bytes({ 0x41, 0xBD }); imm32(op.operand);                // mov r13d, imm32
+                        break;
+                    case Handler::STORE:
+                        countRetired(1);
+                        storeAcc(op.operand);
+                        break;
+                    case Handler::ADD:
+                        countRetired(1);
+                        bytes({ 0x41, 0x81, 0xC5 }); imm32(op.operand);          // add r13d, imm32
+                        break;
+                    case Handler::SUB:
+                        countRetired(1);
+                        bytes({ 0x41, 0x81, 0xED }); imm32(op.operand);          // sub r13d, imm32
+                        break;
+                    case Handler::JMP:
+                        countRetired(1);
+                        branch(i, static_cast<uint32_t>(op.operand));
+                        break;
+                    case Handler::JZ: {
+                        countRetired(1);
+                        bytes({ 0x45, 0x85, 0xED });                            // test r13d, r13d
+                        const size_t skip = jnzPlaceholder();
+                        branch(i, static_cast<uint32_t>(op.operand));
+                        patchHere(skip);
+                        break;
+                    }
+                    case Handler::PRINT:
+                        countRetired(1);
+                        if (op.operand == 0) {
+                            bytes({ 0x44, 0x89, 0xEE });                        // mov esi, r13d
+                        } else {
+                            bytes({ 0x41, 0x8B, 0xB4, 0x24 }); imm32(op.operand * 4); // mov esi, [r12+disp32]
+                        }
+                        bytes({ 0x48, 0x89, 0xDF });                            // mov rdi, rbx
+                        bytes({ 0xFF, 0x53, kPrint });                          // call [rbx+print]
+                        break;
+                    case Handler::HALT:
+                        countRetired(1);
+                        bytes({ 0xC6, 0x43, kHalted, 0x01 });                   // mov byte [rbx+halted], 1
+                        setPc(i + 1);
+                        jumpTo(0, 0xE9, kEpilogue, false);
+                        break;
+                    case Handler::END:
+                        setPc(i);
+                        epilogue = buffer.size();
+                        bytes({ 0x44, 0x89, 0x6B, kAcc });                      // mov [rbx+acc], r13d
+                        bytes({ 0x4C, 0x89, 0xF0 });                            // mov rax, r14
+                        bytes({ 0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3 });
+                        break;
+                    case Handler::LOAD_ADD_STORE:
+                        countRetired(3);
+                        bytes({ 0x41, 0xBD }); imm32(op.operand);
+                        storeAcc(program.ops[i + 1].operand);
+                        break;
+                    case Handler::DEC_JZ: {
+                        countRetired(2);
+                        bytes({ 0x41, 0x83, 0xED, 0x01 });                      // sub r13d, 1
+                        const size_t skip = jnzPlaceholder();
+                        branch(i, static_cast<uint32_t>(op.operand));
+                        patchHere(skip);
+                        break;
+                    }
+                    case Handler::DEC_JZ_JMP: {
+                        countRetired(2);
+                        bytes({ 0x41, 0x83, 0xED, 0x01 });
+                        const size_t skip = jnzPlaceholder();
+                        branch(i, static_cast<uint32_t>(op.operand));
+                        patchHere(skip);
+                        countRetired(1);
+                        branch(i, static_cast<uint32_t>(program.ops[i + 1].operand));
+                        break;
+                    }
+                    case Handler::OPERAND:
+                        break;
+                }
+            }
+            // Budget exit stubs: record the resume pc and leave.
+            for (auto& stub : stubs) {
+                stub.first = buffer.size();
+                setPc(stub.second);
+                bytes({ 0xE9 });
+                const int32_t rel = static_cast<int32_t>(epilogue) - static_cast<int32_t>(buffer.size() + 4);
+                imm32(rel);
+            }
+
+            for (const auto& fixup : fixups) {
+                size_t to;
+                if (fixup.stub) to = stubs[fixup.target].first;
+                else if (fixup.target == kEpilogue) to = epilogue;
+                else to = opOffsets[fixup.target];
+                const int32_t rel = static_cast<int32_t>(to) - static_cast<int32_t>(fixup.at + 4);
+                memcpy(&buffer[fixup.at], &rel, 4);
+            }
+
+            const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            regionSize = (buffer.size() + page - 1) / page * page;
+            void* mapped = ::mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED) return false;
+            region = mapped;
+            memcpy(region, buffer.data(), buffer.size());
+            if (::mprotect(region, regionSize, PROT_READ | PROT_EXEC) != 0) return false;
+
+            auto* base = static_cast<const uint8_t*>(region);
+            entries.resize(n);
+            for (uint32_t i = 0; i < n; ++i) {
+                // OPERAND slots are never entered; point them at the END code.
+                const bool operandSlot = program.ops[i].handler == Handler::OPERAND;
+                entries[i] = base + opOffsets[operandSlot ? n - 1 : i];
+            }
+            entry = reinterpret_cast<Entry>(region);
+            vector<uint8_t>().swap(buffer);
+            return true;
+        }
+    };
+#endif
+
+    // INTERPRETER is always available and is the reference; JIT falls back to it
+    // when the backend is not built or a program cannot be compiled.
+    enum class ExecutionEngine {
+        INTERPRETER, JIT
+    };
+
+    // Hot-loop tracing. Taken backward jumps bump a counter on their target; once a
+    // target crosses hot_threshold the VM records the loop body from there as a
+    // linear trace and replays it until a guard fails.
+    struct TraceConfig {
+        bool enabled = true;
+        int32_t hot_threshold = 64;
+        size_t max_length = 256;                // decoded ops walked per trace
+    };
+
+    struct TraceStats {
+        uint64_t recorded = 0;
+        uint64_t aborted = 0;
+        uint64_t entries = 0;
+        uint64_t iterations = 0;
+        uint64_t side_exits = 0;
+        // Iterations induction skipping jumped over, and the instructions they
+        // stand for. Both are included in `iterations` and in RunStats.
+        uint64_t skipped = 0;
+        uint64_t skipped_instructions = 0;
+    };
+
+    // One step of a specialised loop body. Straight-line accumulator arithmetic is
+    // folded into SET/ADD, jumps and NOPs vanish, and every JZ becomes a guard that
+    // leaves the trace at `exit` when the accumulator disagrees with the recording.
+    // `retired` is the cumulative source instruction count once the step completes;
+    // `exit_retired` is the count when a guard leaves through it.
+    struct TraceOp {
+        enum Kind : uint8_t { SET, ADD, STORE, PRINT, GUARD_ZERO, GUARD_NONZERO };
+        Kind kind;
+        int32_t value;
+        uint32_t exit;
+        uint32_t retired;
+        uint32_t exit_retired;
+    };
+
+    // A trace whose body only adds constants, stores and guards against zero is an
+    // induction loop: the accumulator moves by `delta` per iteration, so replay can
+    // skip whole iterations arithmetically. `offsets` holds the accumulator offset
+    // (from the iteration start) after every ADD and at every guard.
+    // Superinstructions lose their identity in a trace, so it carries how many
+    // it covers per iteration, and at each guard how many ran before leaving.
+    struct Trace {
+        vector<TraceOp> ops;
+        uint32_t retired = 0;                   // per full iteration
+        FusionCounts fused;                     // per full iteration
+        vector<FusionCounts> exitFused;         // indexed like ops; set at guards
+        bool induction = false;
+        int64_t delta = 0;
+        int64_t minOffset = 0;
+        int64_t maxOffset = 0;
+        vector<int64_t> guardOffsets;
+    };
+
     class DominionVM {
-        vector<Instruction> program;
-        map<int, int> memory;
-        int pc = 0;
+        // The clock and the cancellation token are only consulted every slice: once
+        // per this many instructions unless paced, once per this much scheduled time
+        // when paced.
+        static constexpr int64_t kClockCheckInterval = 4096;
+        static constexpr uint64_t kPacingGranularityNs = 1000000;
+        // A head whose recording failed must turn hot this many times over before
+        // the next attempt. setTracing caps the threshold so the product fits.
+        static constexpr int32_t kTraceBackoff = 64;
+
+        shared_ptr<const DecodedProgram> program = DecodedProgram::empty();
+        const DecodedOp* code = program->ops;
+        DenseMemory dense;
+        SparseMemory sparse;
+        size_t memorySize = 1;
+        bool useDense = true;
+        int acc = 0;
+        uint32_t pc = 0;
         bool halted = false;
+        PacingPolicy pacing;
+        MemoryConfig memoryConfig;
+        TraceConfig traceConfig;
+        TraceStats traceStats;
+        FusionCounts fusionExecuted;
+        vector<int32_t> hotness;
+        unordered_map<uint32_t, Trace> traces;
+        ExecutionEngine engine = ExecutionEngine::INTERPRETER;
+#if EXECUE_JIT
+        unique_ptr<X64Jit> jit;
+#endif
+
+        execue::OutputSink* output = &execue::OutputSink::standard();
+        execue::CancellationToken cancellation;
+
+        void printValue(int value) {
+            output->value("[VM] OUT: ", value);
+        }
+
+        static void jitPrint(JitState* state, int32_t value) {
+            static_cast<DominionVM*>(state->context)->printValue(value);
+        }
+
+        // Picks the backing store from the address range the program can touch.
+        void planMemory() {
+            const int lowest = program->lowestAddress;
+            const int highest = program->highestAddress;
+            const bool fits = lowest >= 0 && highest < memoryConfig.dense_limit;
+            useDense = memoryConfig.layout == MemoryLayout::DENSE
+                || (memoryConfig.layout == MemoryLayout::AUTO && fits);
+            if (useDense && !fits) {
+                throw runtime_error("Program addresses exceed the dense memory limit.");
+            }
+            memorySize = static_cast<size_t>(highest) + 1;
+        }
+
+        bool finished() const {
+            return halted || code[pc].handler == Handler::END;
+        }
+
+        // Runs about `fuel` instructions from pc and returns how many retired; a
+        // superinstruction may overrun the slice by up to two. Stops early on HALT,
+        // on reaching the END sentinel, or after jumping back to a hot loop head.
+        template <typename Memory>
+        uint64_t dispatch(Memory& memory, int64_t fuel) {
+            const DecodedOp* const base = code;
+            const DecodedOp* ip = base + pc;
+            const int64_t budget = fuel;
+            int32_t* const hot = traceConfig.enabled ? hotness.data() : nullptr;
+            const int32_t threshold = traceConfig.hot_threshold;
+            int a = acc;
+            // Kept local and published once per slice.
+            FusionCounts fused;
+
+            // Each handler charges fuel for the source instructions it retires, so
+            // budgets and pacing count the same work with or without fusion.
+#if EXECUE_THREADED_DISPATCH
+            // Label addresses and computed goto are GNU extensions, and
+            // EXECUE_THREADED_DISPATCH is only set where they exist.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+            static const void* const labels[] = {
+                &&op_nop, &&op_load, &&op_store, &&op_add, &&op_sub,
+                &&op_jmp, &&op_jz, &&op_print, &&op_halt, &&op_end,
+                &&op_load_add_store, &&op_dec_jz, &&op_dec_jz_jmp, &&op_end
+            };
+#define EXECUE_NEXT(retired) do { fuel -= (retired); if (fuel <= 0) goto out; goto *labels[static_cast<uint32_t>(ip->handler)]; } while (0)
+#define EXECUE_JUMP(target, retired) do { \
+                const DecodedOp* to = (target); \
+                if (to <= ip && hot && ++hot[to - base] >= threshold) { ip = to; fuel -= (retired); goto out; } \
+                ip = to; EXECUE_NEXT(retired); } while (0)
+
+            if (fuel <= 0) goto out;
+            goto *labels[static_cast<uint32_t>(ip->handler)];
+        op_nop:   ++ip; EXECUE_NEXT(1);
+        op_load:  a = ip->operand; ++ip; EXECUE_NEXT(1);
+        op_store: memory[ip->operand] = a; ++ip; EXECUE_NEXT(1);
+        op_add:   a = wrapAdd(a, ip->operand); ++ip; EXECUE_NEXT(1);
+        op_sub:   a = wrapSub(a, ip->operand); ++ip; EXECUE_NEXT(1);
+        op_jmp:   EXECUE_JUMP(base + ip->operand, 1);
+        op_jz:    if (a == 0) EXECUE_JUMP(base + ip->operand, 1);
+                  ++ip; EXECUE_NEXT(1);
+        op_print:
+            printValue(ip->operand == 0 ? a : memory[ip->operand]);
+            ++ip; EXECUE_NEXT(1);
+        op_halt:  halted = true; ++ip; --fuel; goto out;
+        op_end:   goto out;
+        op_load_add_store:
+            ++fused.load_add_store;
+            a = ip[0].operand; memory[ip[1].operand] = a; ip += 2; EXECUE_NEXT(3);
+        op_dec_jz:
+            ++fused.dec_jz;
+            a = wrapSub(a, 1);
+            if (a == 0) EXECUE_JUMP(base + ip->operand, 2);
+            ++ip; EXECUE_NEXT(2);
+        op_dec_jz_jmp:
+            ++fused.dec_jz_jmp;
+            a = wrapSub(a, 1);
+            if (a == 0) EXECUE_JUMP(base + ip[0].operand, 2);
+            EXECUE_JUMP(base + ip[1].operand, 3);
+#undef EXECUE_JUMP
+#undef EXECUE_NEXT
+#pragma GCC diagnostic pop
+#else
+            // Taken backward jumps leave the slice once their target is hot.
+            const auto jump = [&](const DecodedOp* to) {
+                const bool backward = to <= ip;
+                ip = to;
+                return backward && hot && ++hot[to - base] >= threshold;
+            };
+            while (fuel > 0) {
+                switch (ip->handler) {
+                    case Handler::NOP: ++ip; --fuel; break;
+                    case Handler::LOAD: a = ip->operand; ++ip; --fuel; break;
+                    case Handler::STORE: memory[ip->operand] = a; ++ip; --fuel; break;
+                    case Handler::ADD: a = wrapAdd(a, ip->operand); ++ip; --fuel; break;
+                    case Handler::SUB: a = wrapSub(a, ip->operand); ++ip; --fuel; break;
+                    case Handler::JMP:
+                        --fuel;
+                        if (jump(base + ip->operand)) goto out;
+                        break;
+                    case Handler::JZ:
+                        --fuel;
+                        if (a != 0) ++ip;
+                        else if (jump(base + ip->operand)) goto out;
+                        break;
+                    case Handler::PRINT:
+                        printValue(ip->operand == 0 ? a : memory[ip->operand]);
+                        ++ip;
+                        --fuel;
+                        break;
+                    case Handler::HALT: halted = true; ++ip; --fuel; goto out;
+                    case Handler::END: case Handler::OPERAND: goto out;
+                    case Handler::LOAD_ADD_STORE:
+                        ++fused.load_add_store;
+                        a = ip[0].operand;
+                        memory[ip[1].operand] = a;
+                        ip += 2;
+                        fuel -= 3;
+                        break;
+                    case Handler::DEC_JZ:
+                        ++fused.dec_jz;
+                        fuel -= 2;
+                        a = wrapSub(a, 1);
+                        if (a != 0) ++ip;
+                        else if (jump(base + ip->operand)) goto out;
+                        break;
+                    case Handler::DEC_JZ_JMP:
+                        ++fused.dec_jz_jmp;
+                        a = wrapSub(a, 1);
+                        if (a == 0) {
+                            fuel -= 2;
+                            if (jump(base + ip[0].operand)) goto out;
+                        } else {
+                            fuel -= 3;
+                            if (jump(base + ip[1].operand)) goto out;
+                        }
+                        break;
+                }
+            }
+#endif
+        out:
+            acc = a;
+            pc = static_cast<uint32_t>(ip - base);
+            fusionExecuted.add(fused);
+            return static_cast<uint64_t>(budget - fuel);
+        }
+
+        // The accumulator wraps on overflow in every engine (the JIT gets this from
+        // the hardware), so the interpreter, traces and native code always agree.
+        static int32_t wrapAdd(int32_t a, int32_t b) {
+            return static_cast<int32_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b));
+        }
+
+        static int32_t wrapSub(int32_t a, int32_t b) {
+            return static_cast<int32_t>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b));
+        }
+
+        // Walks one iteration of the loop at `head` without side effects. The
+        // accumulator is the only state a branch can observe and no instruction reads
+        // it back from memory, so following it on a local copy yields exactly the
+        // path the next iteration will take.
+        bool recordTrace(uint32_t head, Trace& trace) const {
+            int a = acc;
+            uint32_t at = head;
+            uint32_t retired = 0;
+            FusionCounts fused;
+            const auto emit = [&](TraceOp::Kind kind, int32_t value, uint32_t exit = 0, uint32_t exitRetired = 0) {
+                auto& ops = trace.ops;
+                const bool foldable = kind == TraceOp::ADD && !ops.empty()
+                    && (ops.back().kind == TraceOp::SET || ops.back().kind == TraceOp::ADD);
+                if (foldable) {
+                    ops.back().value = wrapAdd(ops.back().value, value);
+                    ops.back().retired = retired;
+                } else if (kind == TraceOp::ADD && value == 0) {
+                    // Nothing to do; `retired` is cumulative, so the count carries over.
+                } else {
+                    ops.push_back({ kind, value, exit, retired, exitRetired });
+                }
+            };
+            const auto guard = [&](bool zero, uint32_t exit, uint32_t exitRetired) {
+                emit(zero ? TraceOp::GUARD_ZERO : TraceOp::GUARD_NONZERO, 0, exit, exitRetired);
+                trace.exitFused.resize(trace.ops.size());
+                trace.exitFused.back() = fused;
+            };
+
+            for (size_t walked = 0; walked < traceConfig.max_length; ++walked) {
+                if (walked > 0 && at == head) {
+                    trace.retired = retired;
+                    trace.fused = fused;
+                    classifyInduction(trace);
+                    return !trace.ops.empty();
+                }
+                const DecodedOp& op = code[at];
+                switch (op.handler) {
+                    case Handler::NOP: ++retired; ++at; break;
+                    case Handler::LOAD: a = op.operand; ++retired; emit(TraceOp::SET, a); ++at; break;
+                    case Handler::ADD: a = wrapAdd(a, op.operand); ++retired; emit(TraceOp::ADD, op.operand); ++at; break;
+                    case Handler::SUB: a = wrapSub(a, op.operand); ++retired; emit(TraceOp::ADD, wrapSub(0, op.operand)); ++at; break;
+                    case Handler::STORE: ++retired; emit(TraceOp::STORE, op.operand); ++at; break;
+                    case Handler::PRINT: ++retired; emit(TraceOp::PRINT, op.operand); ++at; break;
+                    case Handler::JMP: ++retired; at = static_cast<uint32_t>(op.operand); break;
+                    case Handler::JZ:
+                        ++retired;
+                        guard(a == 0, a == 0 ? at + 1 : static_cast<uint32_t>(op.operand), retired);
+                        at = a == 0 ? static_cast<uint32_t>(op.operand) : at + 1;
+                        break;
+                    case Handler::LOAD_ADD_STORE:
+                        ++fused.load_add_store;
+                        a = op.operand;
+                        retired += 2;
+                        emit(TraceOp::SET, a);
+                        ++retired;
+                        emit(TraceOp::STORE, code[at + 1].operand);
+                        at += 2;
+                        break;
+                    case Handler::DEC_JZ:
+                        ++fused.dec_jz;
+                        a = wrapSub(a, 1);
+                        ++retired;
+                        emit(TraceOp::ADD, -1);
+                        ++retired;
+                        guard(a == 0, a == 0 ? at + 1 : static_cast<uint32_t>(op.operand), retired);
+                        at = a == 0 ? static_cast<uint32_t>(op.operand) : at + 1;
+                        break;
+                    case Handler::DEC_JZ_JMP:
+                        ++fused.dec_jz_jmp;
+                        a = wrapSub(a, 1);
+                        ++retired;
+                        emit(TraceOp::ADD, -1);
+                        ++retired;
+                        // Leaving through the guard takes the other arm: the JMP when
+                        // the recording jumped to t, the JZ target when it did not.
+                        guard(a == 0,
+                              static_cast<uint32_t>(a == 0 ? code[at + 1].operand : op.operand),
+                              a == 0 ? retired + 1 : retired);
+                        if (a == 0) {
+                            at = static_cast<uint32_t>(op.operand);
+                        } else {
+                            ++retired;
+                            at = static_cast<uint32_t>(code[at + 1].operand);
+                        }
+                        break;
+                    default:
+                        return false;           // HALT or END: not a loop
+                }
+            }
+            return false;
+        }
+
+        static void classifyInduction(Trace& trace) {
+            int64_t offset = 0;
+            for (const TraceOp& op : trace.ops) {
+                if (op.kind == TraceOp::SET || op.kind == TraceOp::PRINT || op.kind == TraceOp::GUARD_ZERO) return;
+                if (op.kind == TraceOp::ADD) offset += op.value;
+                if (op.kind == TraceOp::GUARD_NONZERO) trace.guardOffsets.push_back(offset);
+                trace.minOffset = min(trace.minOffset, offset);
+                trace.maxOffset = max(trace.maxOffset, offset);
+            }
+            trace.delta = offset;
+            trace.induction = offset != 0;
+        }
+
+        // How many whole iterations of an induction trace can run from accumulator
+        // `a` before a guard would fail or the accumulator would wrap.
+        static int64_t safeIterations(const Trace& trace, int64_t a) {
+            // Mirror a rising loop onto a falling one so only one direction is handled.
+            const int64_t step = trace.delta < 0 ? -trace.delta : trace.delta;
+            const int64_t sign = trace.delta < 0 ? 1 : -1;
+            const int64_t lowest = sign > 0 ? a + trace.minOffset : -(a + trace.maxOffset);
+            const int64_t floor = sign > 0 ? INT32_MIN : -static_cast<int64_t>(INT32_MAX);
+            int64_t iterations = (lowest - floor) / step + 1;
+            for (int64_t offset : trace.guardOffsets) {
+                const int64_t value = sign * (a + offset);
+                if (value <= 0) {
+                    if (value == 0) return 0;
+                    continue;
+                }
+                if (value % step == 0) iterations = min(iterations, value / step);
+            }
+            return iterations;
+        }
+
+        // Replays `trace` from its head while whole iterations fit in `fuel`.
+        // Returns the instructions retired; pc is left at the head or at the
+        // target of the guard that failed.
+        template <typename Memory>
+        uint64_t replay(const Trace& trace, uint32_t head, Memory& memory, int64_t fuel) {
+            int a = acc;
+            uint64_t retired = 0;
+            uint64_t iterations = 0;
+            ++traceStats.entries;
+            if (trace.induction) {
+                // Skip all but the last safe iteration; running that one normally
+                // leaves every STORE with the value the skipped ones would have left.
+                const int64_t skip = min(safeIterations(trace, a), fuel / static_cast<int64_t>(trace.retired)) - 1;
+                if (skip > 0) {
+                    a = static_cast<int>(a + skip * trace.delta);
+                    retired += static_cast<uint64_t>(skip) * trace.retired;
+                    fuel -= skip * static_cast<int64_t>(trace.retired);
+                    iterations += static_cast<uint64_t>(skip);
+                    traceStats.skipped += static_cast<uint64_t>(skip);
+                    traceStats.skipped_instructions += static_cast<uint64_t>(skip) * trace.retired;
+                }
+            }
+            while (fuel >= static_cast<int64_t>(trace.retired)) {
+                for (const TraceOp& op : trace.ops) {
+                    switch (op.kind) {
+                        case TraceOp::SET: a = op.value; break;
+                        case TraceOp::ADD: a = wrapAdd(a, op.value); break;
+                        case TraceOp::STORE: memory[op.value] = a; break;
+                        case TraceOp::PRINT:
+                            printValue(op.value == 0 ? a : memory[op.value]);
+                            break;
+                        case TraceOp::GUARD_ZERO:
+                        case TraceOp::GUARD_NONZERO:
+                            if ((a == 0) != (op.kind == TraceOp::GUARD_ZERO)) {
+                                ++traceStats.side_exits;
+                                traceStats.iterations += iterations;
+                                fusionExecuted.add(trace.fused, iterations);
+                                fusionExecuted.add(trace.exitFused[&op - trace.ops.data()]);
+                                acc = a;
+                                pc = op.exit;
+                                return retired + op.exit_retired;
+                            }
+                            break;
+                    }
+                }
+                retired += trace.retired;
+                fuel -= trace.retired;
+                ++iterations;
+            }
+            traceStats.iterations += iterations;
+            fusionExecuted.add(trace.fused, iterations);
+            acc = a;
+            pc = head;
+            return retired;
+        }
+
+#if EXECUE_JIT
+        uint64_t runNative(int64_t fuel) {
+            JitState state{ dense.data(), &DominionVM::jitPrint, nullptr, fuel, acc, pc, 0, this };
+            const uint64_t retired = jit->run(state);
+            acc = state.acc;
+            pc = state.pc;
+            halted = halted || state.halted != 0;
+            return retired;
+        }
+#endif
+
+        // One fuel-bounded slice: runs native code when compiled, otherwise
+        // interprets and hands hot loop heads to their trace, recording it first
+        // if needed.
+        template <typename Memory>
+        uint64_t runSlice(Memory& memory, int64_t fuel) {
+#if EXECUE_JIT
+            if constexpr (is_same<Memory, DenseMemory>::value) {
+                if (jit) return runNative(fuel);
+            }
+#endif
+            uint64_t retired = 0;
+            while (fuel > 0 && !finished()) {
+                uint64_t ran = 0;
+                if (traceConfig.enabled && hotness[pc] >= traceConfig.hot_threshold) {
+                    auto found = traces.find(pc);
+                    if (found == traces.end()) {
+                        Trace trace;
+                        if (recordTrace(pc, trace)) {
+                            ++traceStats.recorded;
+                            found = traces.emplace(pc, move(trace)).first;
+                        } else {
+                            // Back off before trying this head again.
+                            ++traceStats.aborted;
+                            hotness[pc] = -kTraceBackoff * traceConfig.hot_threshold;
+                        }
+                    }
+                    if (found != traces.end()) {
+                        hotness[pc] = traceConfig.hot_threshold;
+                        ran = replay(found->second, pc, memory, fuel);
+                    }
+                }
+                if (ran == 0) ran = dispatch(memory, fuel);
+                retired += ran;
+                fuel -= static_cast<int64_t>(ran);
+            }
+            return retired;
+        }
+
+        template <typename Memory>
+        RunStats run(Memory& memory) {
+            using clock = chrono::steady_clock;
+            RunStats stats;
+            const auto start = clock::now();
+            const bool paced = pacing.mode == PacingMode::CYCLE && pacing.cycle_time_ns > 0;
+            const bool timed = pacing.time_budget.count() > 0;
+            const bool cancellable = cancellation.cancellable();
+            const uint64_t limit = pacing.instruction_budget ? pacing.instruction_budget : UINT64_MAX;
+            int64_t slice = INT64_MAX;
+            if (paced) slice = static_cast<int64_t>(max<uint64_t>(1, kPacingGranularityNs / pacing.cycle_time_ns));
+            else if (timed || cancellable) slice = kClockCheckInterval;
+
+            while (!finished()) {
+                if (stats.instructions >= limit) {
+                    stats.reason = StopReason::INSTRUCTION_BUDGET;
+                    break;
+                }
+                const int64_t fuel = static_cast<int64_t>(min<uint64_t>(static_cast<uint64_t>(slice), limit - stats.instructions));
+                stats.instructions += runSlice(memory, fuel);
+                if (finished()) continue;
+                if (cancellable && cancellation.cancelled()) {
+                    stats.reason = StopReason::CANCELLED;
+                    break;
+                }
+                if (!paced && !timed) continue;
+
+                const auto now = clock::now();
+                if (timed && now - start >= pacing.time_budget) {
+                    stats.reason = StopReason::TIME_BUDGET;
+                    break;
+                }
+                if (paced) {
+                    const auto deadline = start + chrono::nanoseconds(stats.instructions * pacing.cycle_time_ns);
+                    if (deadline > now) this_thread::sleep_until(deadline);
+                }
+            }
+
+            if (halted) stats.reason = StopReason::HALTED;
+            output->flush();
+            stats.elapsed = clock::now() - start;
+            return stats;
+        }
+
     public:
+        static constexpr const char* dispatcherName() {
+            return EXECUE_THREADED_DISPATCH ? "threaded" : "switch";
+        }
+
         void load(const vector<Instruction>& prog) {
-            program = prog;
+            load(DecodedProgram::fromInstructions(prog));
+        }
+
+        void load(shared_ptr<const DecodedProgram> decoded) {
+            program = move(decoded);
+            code = program->ops;
+            hotness.assign(program->size, 0);
+            traces.clear();
+            traceStats = {};
+            fusionExecuted = {};
+            planMemory();
+#if EXECUE_JIT
+            jit.reset();
+            if (engine == ExecutionEngine::JIT && useDense) jit = X64Jit::compile(*program);
+#endif
+            reset();
+        }
+
+        // Rewinds the loaded program and clears the register and memory.
+        void reset() {
             pc = 0;
+            acc = 0;
             halted = false;
+            if (useDense) dense.reset(memorySize);
+            else sparse.reset(memorySize);
+        }
+
+        // PRINT goes here; buffered sinks are flushed whenever execute() returns.
+        // The default is the shared stdout sink, which locks per record; VMs on
+        // worker threads are better off with a sink of their own.
+        void setOutput(execue::OutputSink& sink) {
+            output = &sink;
+        }
+
+        void setPacing(const PacingPolicy& policy) {
+            pacing = policy;
+        }
+
+        // execute() polls the token between slices and stops with
+        // StopReason::CANCELLED once it is cancelled.
+        void setCancellation(execue::CancellationToken token) {
+            cancellation = move(token);
+        }
+
+        // Takes effect on the next load().
+        void setMemoryConfig(const MemoryConfig& config) {
+            memoryConfig = config;
+        }
+
+        // Takes effect on the next load().
+        void setEngine(ExecutionEngine selected) {
+            engine = selected;
+        }
+
+        bool jitActive() const {
+#if EXECUE_JIT
+            return jit != nullptr;
+#else
+            return false;
+#endif
         }
 
-        void execute() {
-            while (!halted && pc < program.size()) {
-                const auto& instr = program[pc];
-                switch (instr.opcode) {
-                    case Opcode::NOP: break;
-                    case Opcode::LOAD: memory[0] = instr.operand; break;
-                    case Opcode::STORE: memory[instr.operand] = memory[0]; break;
-                    case Opcode::ADD: memory[0] += instr.operand; break;
-                    case Opcode::SUB: memory[0] -= instr.operand; break;
-                    case Opcode::JMP: pc = instr.operand - 1; break;
-                    case Opcode::JZ: if (memory[0] == 0) pc = instr.operand - 1; break;
-                    case Opcode::PRINT: cout << "[VM] OUT: " << memory[instr.operand] << endl; break;
-                    case Opcode::HALT: halted = true; break;
+        int accumulator() const {
+            return acc;
+        }
+
+        // Dense memory contents; empty when the sparse layout is in use.
+        vector<int> memorySnapshot() const {
+            return useDense ? dense.contents() : vector<int>();
+        }
+
+        void setTracing(const TraceConfig& config) {
+            traceConfig = config;
+            traceConfig.hot_threshold = clamp(traceConfig.hot_threshold, 1, INT32_MAX / kTraceBackoff);
+        }
+
+        const TraceStats& tracingStats() const {
+            return traceStats;
+        }
+
+        // Superinstructions executed since load(). Native code does not count
+        // them, so these stay at zero while the JIT is active.
+        const FusionCounts& fusionCounts() const {
+            return fusionExecuted;
+        }
+
+        bool usesDenseMemory() const {
+            return useDense;
+        }
+
+        RunStats execute() {
+            return useDense ? run(dense) : run(sparse);
+        }
+    };
+
+    struct BatchOptions {
+        size_t workers = 0;  // 0: one per hardware thread
+        PacingPolicy pacing;
+        MemoryConfig memory;
+        TraceConfig tracing;
+        ExecutionEngine engine = ExecutionEngine::INTERPRETER;
+        execue::SinkMode output = execue::SinkMode::BUFFERED;
+        bool capture_output = false;  // keep PRINT output per instance instead of writing stdout
+        bool capture_memory = false;
+        execue::CancellationToken cancellation;  // stops every instance still running
+    };
+
+    struct BatchResult {
+        size_t instance = 0;
+        size_t worker = 0;
+        RunStats stats;
+        chrono::nanoseconds wall{ 0 };  // load/reset plus execution
+        int acc = 0;
+        vector<int> memory;  // only with capture_memory and dense memory
+        string output;       // only with capture_output
+        string error;
+    };
+
+    // Runs many DominionVM instances over a fixed pool of worker threads. The
+    // decoded programs are shared read-only between instances; every worker owns
+    // one VM (memory, traces, JIT code) and reuses it across the instances it
+    // runs, so an instance costs a memory reset rather than a reload.
+    //
+    // Instances are dealt out in contiguous blocks to per-worker deques. A worker
+    // drains its own deque from the front and, once empty, steals from the back
+    // of the others, so long-running instances do not leave cores idle.
+    class BatchExecutor {
+        struct alignas(64) Lane {
+            mutex lock;
+            deque<size_t> pending;
+        };
+
+        // Per-worker state. Each worker buffers into its own sink, flushed at the
+        // end of every instance, so instances on stdout interleave whole.
+        struct Worker {
+            DominionVM vm;
+            ostringstream captured;
+            execue::OutputSink sink;
+            const DecodedProgram* loaded = nullptr;
+
+            explicit Worker(const BatchOptions& options)
+                : sink(options.capture_output ? static_cast<ostream&>(captured) : cout, options.output) {
+                vm.setPacing(options.pacing);
+                vm.setCancellation(options.cancellation);
+                vm.setMemoryConfig(options.memory);
+                vm.setTracing(options.tracing);
+                vm.setEngine(options.engine);
+                vm.setOutput(sink);
+            }
+        };
+
+        struct Batch {
+            const vector<shared_ptr<const DecodedProgram>>* programs;
+            vector<BatchResult>* results;
+        };
+
+        BatchOptions options;
+        vector<unique_ptr<Lane>> lanes;
+        vector<thread> workers;
+        mutex control;
+        condition_variable wake;
+        condition_variable finished;
+        uint64_t generation = 0;
+        bool stopping = false;
+        Batch batch{};
+        atomic<size_t> remaining{ 0 };
+
+        bool take(size_t self, size_t& index) {
+            {
+                Lane& own = *lanes[self];
+                lock_guard<mutex> guard(own.lock);
+                if (!own.pending.empty()) {
+                    index = own.pending.front();
+                    own.pending.pop_front();
+                    return true;
+                }
+            }
+            for (size_t step = 1; step < lanes.size(); ++step) {
+                Lane& victim = *lanes[(self + step) % lanes.size()];
+                lock_guard<mutex> guard(victim.lock);
+                if (!victim.pending.empty()) {
+                    index = victim.pending.back();
+                    victim.pending.pop_back();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void runInstance(Worker& worker, size_t self, size_t index) {
+            DominionVM& vm = worker.vm;
+            const DecodedProgram*& loaded = worker.loaded;
+            const auto& program = (*batch.programs)[index];
+            BatchResult& result = (*batch.results)[index];
+            result.instance = index;
+            result.worker = self;
+            const auto start = chrono::steady_clock::now();
+            try {
+                if (loaded == program.get()) {
+                    vm.reset();
+                } else {
+                    loaded = nullptr;
+                    vm.load(program);
+                    loaded = program.get();
+                }
+                result.stats = vm.execute();
+                result.acc = vm.accumulator();
+                if (options.capture_memory) result.memory = vm.memorySnapshot();
+            } catch (const exception& e) {
+                result.error = e.what();
+                worker.sink.flush();
+            }
+            result.wall = chrono::steady_clock::now() - start;
+            if (options.capture_output) {
+                result.output = worker.captured.str();
+                worker.captured.str(string());
+            }
+        }
+
+        void workerLoop(size_t self) {
+            Worker worker(options);
+            uint64_t seen = 0;
+            for (;;) {
+                {
+                    unique_lock<mutex> guard(control);
+                    wake.wait(guard, [&] { return stopping || generation != seen; });
+                    if (stopping) return;
+                    seen = generation;
+                }
+                size_t index;
+                while (take(self, index)) {
+                    runInstance(worker, self, index);
+                    if (remaining.fetch_sub(1, memory_order_acq_rel) == 1) {
+                        lock_guard<mutex> guard(control);
+                        finished.notify_all();
+                    }
                 }
-                ++pc;
-                this_thread::sleep_for(chrono::milliseconds(10));
             }
         }
+
+    public:
+        explicit BatchExecutor(const BatchOptions& config = BatchOptions()) : options(config) {
+            size_t count = options.workers;
+            if (count == 0) count = max(1u, thread::hardware_concurrency());
+            options.workers = count;
+            for (size_t i = 0; i < count; ++i) lanes.push_back(make_unique<Lane>());
+            workers.reserve(count);
+            for (size_t i = 0; i < count; ++i) workers.emplace_back(&BatchExecutor::workerLoop, this, i);
+        }
+
+        BatchExecutor(const BatchExecutor&) = delete;
+        BatchExecutor& operator=(const BatchExecutor&) = delete;
+
+        ~BatchExecutor() {
+            {
+                lock_guard<mutex> guard(control);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (auto& worker : workers) worker.join();
+        }
+
+        size_t workerCount() const {
+            return workers.size();
+        }
+
+        // Runs one instance per entry; entries may repeat the same program. A
+        // failing instance reports its error in its result and does not stop the
+        // batch. Not reentrant: one batch runs at a time.
+        vector<BatchResult> run(const vector<shared_ptr<const DecodedProgram>>& programs) {
+            vector<BatchResult> results(programs.size());
+            if (programs.empty()) return results;
+
+            unique_lock<mutex> guard(control);
+            // Published before any index is queued: a worker still draining the
+            // previous batch may pick up new work as soon as it appears.
+            batch = Batch{ &programs, &results };
+            remaining.store(programs.size(), memory_order_relaxed);
+            const size_t block = (programs.size() + lanes.size() - 1) / lanes.size();
+            for (size_t first = 0; first < programs.size(); first += block) {
+                Lane& lane = *lanes[first / block];
+                lock_guard<mutex> queued(lane.lock);
+                for (size_t i = first; i < min(first + block, programs.size()); ++i) lane.pending.push_back(i);
+            }
+            ++generation;
+            wake.notify_all();
+            finished.wait(guard, [&] { return remaining.load(memory_order_acquire) == 0; });
+            batch = Batch{};
+            return results;
+        }
+
+        vector<BatchResult> run(const shared_ptr<const DecodedProgram>& program, size_t instances) {
+            return run(vector<shared_ptr<const DecodedProgram>>(instances, program));
+        }
+    };
+
+    // Read-only view of a whole file: mmap where available, an aligned heap copy
+    // elsewhere. `storage` owns the bytes; an empty file yields length 0.
+    struct MappedFile {
+        shared_ptr<const void> storage;
+        const char* bytes = nullptr;
+        size_t length = 0;
+
+        static MappedFile open(const string& filename) {
+            MappedFile file;
+#if defined(__unix__) || defined(__APPLE__)
+            const int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0) throw runtime_error("Cannot open file: " + filename);
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                ::close(fd);
+                throw runtime_error("Cannot stat file: " + filename);
+            }
+            const size_t length = static_cast<size_t>(info.st_size);
+            if (length == 0) {
+                ::close(fd);
+                return file;
+            }
+            void* mapped = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (mapped == MAP_FAILED) throw runtime_error("Cannot map file: " + filename);
+            file.bytes = static_cast<const char*>(mapped);
+            file.length = length;
+            file.storage = shared_ptr<const void>(mapped, [length](const void* p) {
+                ::munmap(const_cast<void*>(p), length);
+            });
+#else
+            ifstream in(filename, ios::binary | ios::ate);
+            if (!in) throw runtime_error("Cannot open file: " + filename);
+            file.length = static_cast<size_t>(in.tellg());
+            auto buffer = make_shared<vector<uint64_t>>((file.length + 7) / 8);
+            in.seekg(0);
+            in.read(reinterpret_cast<char*>(buffer->data()), file.length);
+            file.bytes = reinterpret_cast<const char*>(buffer->data());
+            file.storage = move(buffer);
+#endif
+            return file;
+        }
     };
 
     class Parser {
+        struct Mnemonic {
+            const char* name;
+            size_t length;
+            Opcode opcode;
+        };
+
+        // Perfect hash over the nine mnemonics: (first + second + length) & 15 is
+        // collision-free, so a lookup is one table probe and one memcmp.
+        static constexpr size_t kMnemonicSlots = 16;
+
+        static constexpr size_t mnemonicSlot(const char* token, size_t length) {
+            return (static_cast<unsigned char>(token[0]) + static_cast<unsigned char>(token[1]) + length)
+                & (kMnemonicSlots - 1);
+        }
+
+        static const Mnemonic* lookupMnemonic(const char* token, size_t length) {
+            static const auto table = [] {
+                const Mnemonic mnemonics[] = {
+                    { "NOP", 3, Opcode::NOP }, { "LOAD", 4, Opcode::LOAD }, { "STORE", 5, Opcode::STORE },
+                    { "ADD", 3, Opcode::ADD }, { "SUB", 3, Opcode::SUB }, { "JMP", 3, Opcode::JMP },
+                    { "JZ", 2, Opcode::JZ }, { "PRINT", 5, Opcode::PRINT }, { "HALT", 4, Opcode::HALT },
+                };
+                array<Mnemonic, kMnemonicSlots> slots{};
+                for (const auto& m : mnemonics) slots[mnemonicSlot(m.name, m.length)] = m;
+                return slots;
+            }();
+            if (length < 2) return nullptr;
+            const Mnemonic& m = table[mnemonicSlot(token, length)];
+            return m.name && m.length == length && memcmp(m.name, token, length) == 0 ? &m : nullptr;
+        }
+
+        [[noreturn]] static void fail(const string& filename, size_t line, size_t column, const string& message) {
+            throw runtime_error(filename + ":" + to_string(line) + ":" + to_string(column) + ": " + message);
+        }
+
     public:
+        // Single pass over the mapped file. Each line is `MNEMONIC [operand]`; a missing
+        // operand reads as 0 and blank lines are skipped. As with the iostream loader
+        // this replaced, a non-numeric operand also reads as 0 and anything after the
+        // operand is ignored; only an operand that does not fit an int is an error.
         static vector<Instruction> parseEXU(const string& filename) {
-            ifstream file(filename);
-            if (!file) throw runtime_error("Cannot open file.");
+            const MappedFile file = MappedFile::open(filename);
+            const char* p = file.bytes;
+            const char* const end = file.bytes + file.length;
             vector<Instruction> instructions;
-            string line;
-            while (getline(file, line)) {
-                istringstream ss(line);
-                string op;
-                int val = 0;
-                ss >> op >> val;
-                Opcode code;
-                if (op == "NOP") code = Opcode::NOP;
-                else if (op == "LOAD") code = Opcode::LOAD;
-                else if (op == "STORE") code = Opcode::STORE;
-                else if (op == "ADD") code = Opcode::ADD;
-                else if (op == "SUB") code = Opcode::SUB;
-                else if (op == "JMP") code = Opcode::JMP;
-                else if (op == "JZ") code = Opcode::JZ;
-                else if (op == "PRINT") code = Opcode::PRINT;
-                else if (op == "HALT") code = Opcode::HALT;
-                else throw runtime_error("Invalid opcode: " + op);
-                instructions.push_back({ code, val });
+            instructions.reserve(file.length / 6 + 1);
+
+            size_t line = 1;
+            const char* lineStart = p;
+            const auto column = [&](const char* at) { return static_cast<size_t>(at - lineStart) + 1; };
+            const auto isBlank = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+
+            while (p < end) {
+                while (p < end && isBlank(*p)) ++p;
+                if (p == end) break;
+                if (*p == '\n') {
+                    ++p;
+                    ++line;
+                    lineStart = p;
+                    continue;
+                }
+
+                const char* token = p;
+                while (p < end && !isBlank(*p) && *p != '\n') ++p;
+                const Mnemonic* mnemonic = lookupMnemonic(token, static_cast<size_t>(p - token));
+                if (!mnemonic) fail(filename, line, column(token), "Invalid opcode: " + string(token, p));
+
+                while (p < end && isBlank(*p)) ++p;
+                int operand = 0;
+                if (p < end && *p != '\n') {
+                    if (*p == '+' && p + 1 < end && *(p + 1) != '-') ++p;    // from_chars takes no '+'
+                    const auto [next, error] = from_chars(p, end, operand);
+                    if (error == errc::result_out_of_range) fail(filename, line, column(p), "Operand out of range");
+                    if (error == errc()) p = next;
+                    while (p < end && *p != '\n') ++p;
+                }
+                instructions.push_back({ mnemonic->opcode, operand });
             }
             return instructions;
         }
     };
 
+    // .exb: binary DominionVM bytecode. The opcode stream is stored exactly as
+    // DecodedOp records (END sentinel included, jumps already resolved), so a mapped
+    // file executes in place. All fields are little-endian.
+    //
+    //   header   ExbHeader, 48 bytes
+    //   opcodes  op_count x DecodedOp, 8-byte aligned
+    //   consts   const_count x int32, indexed by ExbConstant
+    //
+    // Version 2 streams may contain superinstructions; version 1 streams are read
+    // unchanged.
+    constexpr char kExbMagic[4] = { 'E', 'X', 'B', '\0' };
+    constexpr uint16_t kExbVersion = 2;
+    constexpr uint32_t kExbByteOrder = 0x01020304;
+
+    struct ExbHeader {
+        char magic[4];
+        uint16_t version;
+        uint16_t flags;
+        uint32_t byte_order;
+        uint32_t op_count;
+        uint32_t const_count;
+        uint32_t reserved;
+        uint64_t op_offset;
+        uint64_t const_offset;
+        uint64_t file_size;
+    };
+    static_assert(sizeof(ExbHeader) == 48, "ExbHeader layout is part of the file format");
+    static_assert(sizeof(DecodedOp) == 8, "DecodedOp layout is part of the file format");
+
+    // Constant section slots. Readers ignore slots they do not know.
+    enum ExbConstant : uint32_t {
+        EXB_LOWEST_ADDRESS,
+        EXB_HIGHEST_ADDRESS,
+        EXB_SOURCE_INSTRUCTIONS,
+        EXB_FUSED_LOAD_ADD_STORE,
+        EXB_FUSED_DEC_JZ,
+        EXB_FUSED_DEC_JZ_JMP,
+        EXB_CONSTANT_COUNT
+    };
+
+    class ExbFile {
+    public:
+        static void write(const string& filename, const vector<Instruction>& program,
+                          const DecodeOptions& options = {}) {
+            auto decoded = DecodedProgram::fromInstructions(program, options);
+            const int32_t consts[EXB_CONSTANT_COUNT] = {
+                decoded->lowestAddress,
+                decoded->highestAddress,
+                static_cast<int32_t>(program.size()),
+                static_cast<int32_t>(decoded->fusion.load_add_store),
+                static_cast<int32_t>(decoded->fusion.dec_jz),
+                static_cast<int32_t>(decoded->fusion.dec_jz_jmp),
+            };
+
+            ExbHeader header{};
+            memcpy(header.magic, kExbMagic, sizeof(kExbMagic));
+            header.version = kExbVersion;
+            header.byte_order = kExbByteOrder;
+            header.op_count = static_cast<uint32_t>(decoded->size);
+            header.const_count = EXB_CONSTANT_COUNT;
+            header.op_offset = sizeof(ExbHeader);
+            header.const_offset = header.op_offset + decoded->size * sizeof(DecodedOp);
+            header.file_size = header.const_offset + sizeof(consts);
+
+            ofstream out(filename, ios::binary | ios::trunc);
+            if (!out) throw runtime_error("Cannot write file: " + filename);
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(decoded->ops), decoded->size * sizeof(DecodedOp));
+            out.write(reinterpret_cast<const char*>(consts), sizeof(consts));
+            if (!out) throw runtime_error("Failed writing file: " + filename);
+        }
+
+        // Maps an .exb file and returns a program that executes straight from the
+        // mapping. `verify` scans the stream once for bad handlers, jumps and
+        // addresses, and checks the constants against it; skip it only for files
+        // this build produced.
+        static shared_ptr<const DecodedProgram> load(const string& filename, bool verify = true) {
+            MappedFile file = MappedFile::open(filename);
+            const char* const bytes = file.bytes;
+            const size_t length = file.length;
+
+            if (length < sizeof(ExbHeader)) throw runtime_error("Truncated .exb header: " + filename);
+            ExbHeader header;
+            memcpy(&header, bytes, sizeof(header));
+            if (memcmp(header.magic, kExbMagic, sizeof(kExbMagic)) != 0)
+                throw runtime_error("Not an .exb file: " + filename);
+            if (header.byte_order != kExbByteOrder)
+                throw runtime_error("Unsupported .exb byte order: " + filename);
+            if (header.version == 0 || header.version > kExbVersion)
+                throw runtime_error("Unsupported .exb version " + to_string(header.version) + ": " + filename);
+            if (header.file_size != length || header.op_count == 0
+                || header.op_offset % alignof(DecodedOp) != 0
+                || header.op_offset > length
+                || header.op_count > (length - header.op_offset) / sizeof(DecodedOp)
+                || header.const_offset > length
+                || header.const_count > (length - header.const_offset) / sizeof(int32_t)
+                || header.const_count < EXB_HIGHEST_ADDRESS + 1)
+                throw runtime_error("Corrupt .exb section table: " + filename);
+
+            auto program = make_shared<DecodedProgram>();
+            program->ops = reinterpret_cast<const DecodedOp*>(bytes + header.op_offset);
+            program->size = header.op_count;
+            memcpy(&program->lowestAddress, bytes + header.const_offset + EXB_LOWEST_ADDRESS * sizeof(int32_t), sizeof(int32_t));
+            memcpy(&program->highestAddress, bytes + header.const_offset + EXB_HIGHEST_ADDRESS * sizeof(int32_t), sizeof(int32_t));
+            if (header.const_count > EXB_FUSED_DEC_JZ_JMP) {
+                memcpy(&program->fusion.load_add_store, bytes + header.const_offset + EXB_FUSED_LOAD_ADD_STORE * sizeof(int32_t), sizeof(int32_t));
+                memcpy(&program->fusion.dec_jz, bytes + header.const_offset + EXB_FUSED_DEC_JZ * sizeof(int32_t), sizeof(int32_t));
+                memcpy(&program->fusion.dec_jz_jmp, bytes + header.const_offset + EXB_FUSED_DEC_JZ_JMP * sizeof(int32_t), sizeof(int32_t));
+            }
+            program->storage = move(file.storage);
+            if (verify) verifyStream(*program, header, bytes + header.const_offset, filename);
+            return program;
+        }
+
+    private:
+        static void verifyStream(const DecodedProgram& program, const ExbHeader& header, const char* consts,
+                                 const string& filename) {
+            const auto last = static_cast<int32_t>(program.size - 1);
+            const auto fail = [&](const char* what, int32_t at) {
+                throw runtime_error(string(what) + " at op " + to_string(at) + ": " + filename);
+            };
+            const auto checkJump = [&](int32_t target, int32_t at) {
+                if (target < 0 || target > last || program.ops[target].handler == Handler::OPERAND)
+                    fail("Jump out of range", at);
+            };
+            const auto checkAddress = [&](int32_t address, int32_t at) {
+                if (address < program.lowestAddress || address > program.highestAddress)
+                    fail("Address outside declared range", at);
+            };
+
+            // The writer's range always takes in address 0, the accumulator.
+            if (program.lowestAddress > 0 || program.highestAddress < 0)
+                throw runtime_error("Inconsistent .exb address range: " + filename);
+            if (program.ops[last].handler != Handler::END) fail("Missing END sentinel", last);
+            FusionStats fused;
+            for (int32_t i = 0; i < last; ++i) {
+                const DecodedOp& op = program.ops[i];
+                const bool wide = op.handler == Handler::LOAD_ADD_STORE || op.handler == Handler::DEC_JZ_JMP;
+                if (wide && (i + 1 >= last || program.ops[i + 1].handler != Handler::OPERAND))
+                    fail("Missing superinstruction operand", i);
+                switch (op.handler) {
+                    case Handler::JMP: case Handler::JZ: case Handler::DEC_JZ:
+                        checkJump(op.operand, i);
+                        if (op.handler == Handler::DEC_JZ) ++fused.dec_jz;
+                        break;
+                    case Handler::DEC_JZ_JMP:
+                        checkJump(op.operand, i);
+                        checkJump(program.ops[i + 1].operand, i);
+                        ++fused.dec_jz_jmp;
+                        break;
+                    case Handler::STORE: case Handler::PRINT:
+                        checkAddress(op.operand, i);
+                        break;
+                    case Handler::LOAD_ADD_STORE:
+                        checkAddress(program.ops[i + 1].operand, i);
+                        ++fused.load_add_store;
+                        break;
+                    case Handler::NOP: case Handler::LOAD: case Handler::ADD:
+                    case Handler::SUB: case Handler::HALT:
+                        break;
+                    default:
+                        fail("Invalid handler", i);
+                }
+                if (wide) ++i;
+            }
+
+            // Every superinstruction stands for one more source instruction than
+            // the slots it takes, so the counts must add up to the stream.
+            const auto constant = [&](ExbConstant slot) {
+                int32_t value;
+                memcpy(&value, consts + slot * sizeof(int32_t), sizeof(value));
+                return value;
+            };
+            const bool recordsFusion = header.const_count > EXB_FUSED_DEC_JZ_JMP;
+            if (recordsFusion && (program.fusion.load_add_store != fused.load_add_store
+                                  || program.fusion.dec_jz != fused.dec_jz
+                                  || program.fusion.dec_jz_jmp != fused.dec_jz_jmp))
+                throw runtime_error("Inconsistent .exb fusion counts: " + filename);
+            const int64_t source = static_cast<int64_t>(last) + fused.load_add_store + fused.dec_jz + fused.dec_jz_jmp;
+            if (header.const_count > EXB_SOURCE_INSTRUCTIONS && constant(EXB_SOURCE_INSTRUCTIONS) != source)
+                throw runtime_error("Inconsistent .exb instruction count: " + filename);
+        }
+    };
+
     class Renderer {
     public:
         static void splashScreen() {
-            cout << "\nEXECUE - Dominion Engine Compiler and Runtime v1.0" << endl;
-            cout << "Rendering Subsystem Initialized..." << endl;
-            cout << "[✓] Terminal Render Layer Loaded" << endl;
+            auto& out = execue::OutputSink::standard();
+            out.line("");
+            out.line("EXECUE - Dominion Engine Compiler and Runtime v1.0");
+            out.line("Rendering Subsystem Initialized...");
+            out.line("[✓] Terminal Render Layer Loaded");
         }
     };
 }
 
+static const char* stopReasonName(ExecueCore::StopReason reason) {
+    switch (reason) {
+        case ExecueCore::StopReason::HALTED: return "halted";
+        case ExecueCore::StopReason::END_OF_PROGRAM: return "end of program";
+        case ExecueCore::StopReason::INSTRUCTION_BUDGET: return "instruction budget exhausted";
+        case ExecueCore::StopReason::TIME_BUDGET: return "time budget exhausted";
+        case ExecueCore::StopReason::CANCELLED: return "cancelled";
+    }
+    return "unknown";
+}
+
+struct BenchCase {
+    const char* name;
+    std::shared_ptr<const ExecueCore::DecodedProgram> program;
+    ExecueCore::MemoryLayout layout;
+    bool trace = false;
+    ExecueCore::ExecutionEngine engine = ExecueCore::ExecutionEngine::INTERPRETER;
+};
+
+// Runs each case and reports instructions per second. Sparse is the map-backed
+// layout the VM used before the dense register file; the unfused cases show what
+// superinstruction fusion buys, the traced case what hot-loop replay adds, and
+// the jit case the native backend.
+static int runBenchmark(const std::vector<BenchCase>& cases, int runs) {
+    using namespace ExecueCore;
+    for (const auto& bench : cases) {
+        DominionVM vm;
+        MemoryConfig config;
+        config.layout = bench.layout;
+        vm.setMemoryConfig(config);
+        TraceConfig tracing;
+        tracing.enabled = bench.trace;
+        vm.setTracing(tracing);
+        vm.setEngine(bench.engine);
+        vm.load(bench.program);
+        if (bench.engine == ExecutionEngine::JIT && !vm.jitActive()) {
+            cerr << "[BENCH] " << bench.name << ": JIT unavailable, skipped" << endl;
+            continue;
+        }
+
+        // Instructions skipped by induction never run, so the rate only counts
+        // the executed ones and stays comparable across engines.
+        double best = 0.0;
+        uint64_t instructions = 0;
+        uint64_t skipped = 0;
+        for (int run = 0; run < runs; ++run) {
+            vm.reset();
+            const uint64_t skippedBefore = vm.tracingStats().skipped_instructions;
+            RunStats stats = vm.execute();
+            const double seconds = chrono::duration<double>(stats.elapsed).count();
+            instructions = stats.instructions;
+            skipped = vm.tracingStats().skipped_instructions - skippedBefore;
+            if (seconds > 0.0) best = max(best, (instructions - skipped) / seconds);
+        }
+        const char* backend = bench.engine == ExecutionEngine::JIT ? "native" : DominionVM::dispatcherName();
+        cerr << "[BENCH] " << bench.name << "/" << backend << ": " << instructions << " instructions";
+        if (skipped > 0) cerr << " (" << skipped << " skipped)";
+        cerr << ", " << static_cast<uint64_t>(best) << " instr/s executed (best of " << runs << ")" << endl;
+    }
+    return 0;
+}
+
+struct EngineResult {
+    ExecueCore::RunStats stats;
+    int acc;
+    std::vector<int> memory;
+    std::string output;
+};
+
+static EngineResult runCaptured(const std::shared_ptr<const ExecueCore::DecodedProgram>& program,
+                                ExecueCore::ExecutionEngine engine, const ExecueCore::PacingPolicy& pacing) {
+    using namespace ExecueCore;
+    DominionVM vm;
+    MemoryConfig config;
+    config.layout = MemoryLayout::DENSE;
+    vm.setMemoryConfig(config);
+    TraceConfig tracing;
+    tracing.enabled = false;
+    vm.setTracing(tracing);
+    vm.setPacing(pacing);
+    vm.setEngine(engine);
+    vm.load(program);
+    if (engine == ExecutionEngine::JIT && !vm.jitActive()) throw runtime_error("JIT unavailable for this program.");
+
+    ostringstream captured;
+    execue::OutputSink sink(captured, execue::SinkMode::BUFFERED);
+    vm.setOutput(sink);
+    EngineResult result;
+    result.stats = vm.execute();
+    result.acc = vm.accumulator();
+    result.memory = vm.memorySnapshot();
+    result.output = captured.str();
+    return result;
+}
+
+// Differential check of the JIT against the reference interpreter: output,
+// accumulator, memory, stop reason and retired instruction count must agree.
+static int verifyJit(const std::shared_ptr<const ExecueCore::DecodedProgram>& program,
+                     const ExecueCore::PacingPolicy& pacing) {
+    using namespace ExecueCore;
+    const EngineResult reference = runCaptured(program, ExecutionEngine::INTERPRETER, pacing);
+    const EngineResult native = runCaptured(program, ExecutionEngine::JIT, pacing);
+    const bool budgeted = reference.stats.reason == StopReason::INSTRUCTION_BUDGET;
+    vector<string> mismatches;
+    if (native.stats.reason != reference.stats.reason) mismatches.push_back("stop reason");
+    if (!budgeted) {
+        // Budgeted runs stop at different points: the JIT only checks at back edges.
+        if (native.stats.instructions != reference.stats.instructions) mismatches.push_back("instruction count");
+        if (native.acc != reference.acc) mismatches.push_back("accumulator");
+        if (native.memory != reference.memory) mismatches.push_back("memory");
+        if (native.output != reference.output) mismatches.push_back("output");
+    }
+    if (mismatches.empty()) {
+        cerr << "[JIT] verified: " << reference.stats.instructions << " instructions match the interpreter" << endl;
+        return 0;
+    }
+    for (const auto& what : mismatches) cerr << "[JIT] mismatch: " << what << endl;
+    return 3;
+}
+
+static void printFusionSites(const ExecueCore::FusionStats& fusion) {
+    std::cerr << "[FUSION] sites: LOAD_ADD_STORE: " << fusion.load_add_store
+              << ", DEC_JZ: " << fusion.dec_jz
+              << ", DEC_JZ_JMP: " << fusion.dec_jz_jmp << std::endl;
+}
+
+// Executed counts first; the static sites they came from follow.
+static void printFusionStats(const ExecueCore::FusionCounts& executed, const ExecueCore::FusionStats& fusion) {
+    std::cerr << "[FUSION] executed: LOAD_ADD_STORE: " << executed.load_add_store
+              << ", DEC_JZ: " << executed.dec_jz
+              << ", DEC_JZ_JMP: " << executed.dec_jz_jmp << std::endl;
+    printFusionSites(fusion);
+}
+
+static void printTraceStats(const ExecueCore::TraceStats& tracing) {
+    std::cerr << "[TRACE] recorded: " << tracing.recorded
+              << ", aborted: " << tracing.aborted
+              << ", entries: " << tracing.entries
+              << ", iterations: " << tracing.iterations
+              << ", side exits: " << tracing.side_exits
+              << ", skipped: " << tracing.skipped << std::endl;
+}
+
+// Runs `instances` copies of the program across the batch pool and reports
+// per-instance timing and aggregate throughput.
+static int runBatch(const std::shared_ptr<const ExecueCore::DecodedProgram>& program, size_t instances,
+                    const ExecueCore::BatchOptions& options) {
+    using namespace ExecueCore;
+    BatchExecutor executor(options);
+    const auto start = chrono::steady_clock::now();
+    const vector<BatchResult> results = executor.run(program, instances);
+    const double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    uint64_t instructions = 0;
+    size_t failed = 0;
+    size_t budgeted = 0;
+    chrono::nanoseconds slowest{ 0 };
+    chrono::nanoseconds total{ 0 };
+    for (const auto& result : results) {
+        if (!result.error.empty()) {
+            cerr << "[BATCH] instance " << result.instance << " failed: " << result.error << endl;
+            ++failed;
+            continue;
+        }
+        if (result.stats.reason == StopReason::INSTRUCTION_BUDGET || result.stats.reason == StopReason::TIME_BUDGET) ++budgeted;
+        instructions += result.stats.instructions;
+        total += result.wall;
+        slowest = max(slowest, result.wall);
+    }
+    const size_t succeeded = results.size() - failed;
+    cerr << "[BATCH] " << results.size() << " instances on " << executor.workerCount() << " workers in "
+         << static_cast<uint64_t>(seconds * 1000.0) << " ms, " << failed << " failed, " << budgeted << " stopped by budget" << endl;
+    if (succeeded > 0) {
+        cerr << "[BATCH] per instance: mean " << total.count() / static_cast<int64_t>(succeeded) / 1000
+             << " us, max " << slowest.count() / 1000 << " us; " << instructions << " instructions";
+        if (seconds > 0.0) cerr << ", " << static_cast<uint64_t>(instructions / seconds) << " instr/s";
+        cerr << endl;
+    }
+    if (failed > 0) return 1;
+    return budgeted > 0 ? 2 : 0;
+}
+
 int main(int argc, char** argv) {
     using namespace ExecueCore;
+    PacingPolicy pacing;
+    MemoryConfig memoryConfig;
+    int benchRuns = 0;
+    DecodeOptions decodeOptions;
+    TraceConfig traceConfig;
+    bool showFusion = false;
+    bool showTracing = false;
+    bool verifyNative = false;
+    ExecutionEngine engine = ExecutionEngine::INTERPRETER;
+    execue::SinkMode outputMode = execue::SinkMode::DIRECT;
+    bool outputChosen = false;
+    size_t batchInstances = 0;
+    size_t batchWorkers = 0;
+    const char* emitPath = nullptr;
+    const char* file = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--paced") == 0) {
+            pacing.mode = PacingMode::CYCLE;
+        } else if (strncmp(arg, "--paced=", 8) == 0) {
+            pacing.mode = PacingMode::CYCLE;
+            pacing.cycle_time_ns = strtoull(arg + 8, nullptr, 10);
+        } else if (strcmp(arg, "--max-instructions") == 0 && i + 1 < argc) {
+            pacing.instruction_budget = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(arg, "--max-ms") == 0 && i + 1 < argc) {
+            pacing.time_budget = chrono::milliseconds(strtoull(argv[++i], nullptr, 10));
+        } else if (strcmp(arg, "--sparse") == 0) {
+            memoryConfig.layout = MemoryLayout::SPARSE;
+        } else if (strcmp(arg, "--no-fuse") == 0) {
+            decodeOptions.fuse = false;
+        } else if (strcmp(arg, "--fusion-stats") == 0) {
+            showFusion = true;
+        } else if (strcmp(arg, "--jit") == 0) {
+            engine = ExecutionEngine::JIT;
+        } else if (strcmp(arg, "--jit-verify") == 0) {
+            verifyNative = true;
+        } else if (strcmp(arg, "--no-trace") == 0) {
+            traceConfig.enabled = false;
+        } else if (strcmp(arg, "--trace-stats") == 0) {
+            showTracing = true;
+        } else if (strcmp(arg, "--batch") == 0 && i + 1 < argc) {
+            batchInstances = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(arg, "--workers") == 0 && i + 1 < argc) {
+            batchWorkers = strtoull(argv[++i], nullptr, 10);
+        } else if (strncmp(arg, "--output=", 9) == 0) {
+            const char* mode = arg + 9;
+            if (strcmp(mode, "direct") == 0) outputMode = execue::SinkMode::DIRECT;
+            else if (strcmp(mode, "buffered") == 0) outputMode = execue::SinkMode::BUFFERED;
+            else if (strcmp(mode, "binary") == 0) outputMode = execue::SinkMode::BINARY;
+            else {
+                cerr << "Unknown output mode: " << mode << endl;
+                return 1;
+            }
+            outputChosen = true;
+        } else if (strcmp(arg, "--emit-exb") == 0 && i + 1 < argc) {
+            emitPath = argv[++i];
+        } else if (strcmp(arg, "--bench") == 0) {
+            benchRuns = 5;
+        } else if (strncmp(arg, "--bench=", 8) == 0) {
+            benchRuns = max(1, atoi(arg + 8));
+        } else {
+            file = arg;
+        }
+    }
+    execue::OutputSink::standard().setMode(outputMode);
     Renderer::splashScreen();
-    if (argc < 2) {
-        cerr << "Usage: executar <file.exu>" << endl;
+    execue::OutputSink::standard().flush();
+    if (!file) {
+        cerr << "Usage: executar [--paced[=cycle_ns]] [--max-instructions N] [--max-ms N] [--sparse] [--no-fuse] [--fusion-stats] [--no-trace] [--trace-stats] [--jit] [--jit-verify] [--output=direct|buffered|binary] [--batch N [--workers N]] [--bench[=runs]] [--emit-exb out.exb] <file.exu|file.exb>" << endl;
         return 1;
     }
 
     try {
-        auto program = Parser::parseEXU(argv[1]);
+        shared_ptr<const DecodedProgram> program;
+        vector<BenchCase> benchCases;
+        const size_t length = strlen(file);
+        if (length > 4 && strcmp(file + length - 4, ".exb") == 0) {
+            program = ExbFile::load(file);
+            benchCases = {
+                { "sparse", program, MemoryLayout::SPARSE },
+                { "dense", program, MemoryLayout::DENSE },
+                { "dense+trace", program, MemoryLayout::DENSE, true },
+                { "dense+jit", program, MemoryLayout::DENSE, false, ExecutionEngine::JIT },
+            };
+        } else {
+            auto instructions = Parser::parseEXU(file);
+            if (emitPath) {
+                ExbFile::write(emitPath, instructions, decodeOptions);
+                return 0;
+            }
+            program = DecodedProgram::fromInstructions(instructions, decodeOptions);
+            if (benchRuns > 0) {
+                auto unfused = DecodedProgram::fromInstructions(instructions, DecodeOptions{ false });
+                auto fused = DecodedProgram::fromInstructions(instructions, DecodeOptions{ true });
+                benchCases = {
+                    { "sparse", unfused, MemoryLayout::SPARSE },
+                    { "dense", unfused, MemoryLayout::DENSE },
+                    { "dense+fused", fused, MemoryLayout::DENSE },
+                    { "dense+fused+trace", fused, MemoryLayout::DENSE, true },
+                    { "dense+fused+jit", fused, MemoryLayout::DENSE, false, ExecutionEngine::JIT },
+                };
+            }
+        }
+        // Only a single run reports executed counts.
+        const bool singleRun = benchRuns == 0 && !verifyNative && batchInstances == 0;
+        if (showFusion && !singleRun) printFusionSites(program->fusion);
+        if (benchRuns > 0) return runBenchmark(benchCases, benchRuns);
+        if (verifyNative) return verifyJit(program, pacing);
+        if (batchInstances > 0) {
+            BatchOptions options;
+            options.workers = batchWorkers;
+            options.pacing = pacing;
+            options.memory = memoryConfig;
+            options.tracing = traceConfig;
+            options.engine = engine;
+            if (outputChosen) options.output = outputMode;
+            return runBatch(program, batchInstances, options);
+        }
         DominionVM vm;
+        vm.setMemoryConfig(memoryConfig);
+        vm.setPacing(pacing);
+        vm.setTracing(traceConfig);
+        vm.setEngine(engine);
         vm.load(program);
-        vm.execute();
+        if (engine == ExecutionEngine::JIT && !vm.jitActive()) {
+            cerr << "[VM] JIT unavailable, using the interpreter" << endl;
+        }
+        RunStats stats = vm.execute();
+        if (showTracing) printTraceStats(vm.tracingStats());
+        if (showFusion) {
+            if (vm.jitActive()) printFusionSites(program->fusion);
+            else printFusionStats(vm.fusionCounts(), program->fusion);
+        }
+        if (stats.reason == StopReason::INSTRUCTION_BUDGET || stats.reason == StopReason::TIME_BUDGET) {
+            cerr << "[VM] Stopped: " << stopReasonName(stats.reason) << " after "
+                 << stats.instructions << " instructions" << endl;
+            return 2;
+        }
     } catch (const exception& e) {
         cerr << "Error: " << e.what() << endl;
         return 1;
@@ -8,6 +8,15 @@
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <cstdint>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include "src/memory/access_policy.h"
 
 // Constants
 const size_t MEMORY_SIZE = 1024;
@@ -20,30 +29,164 @@ enum ExecutionError {
     ERR_MEMORY_OVERFLOW,
     ERR_DIVIDE_BY_ZERO,
     ERR_STACK_OVERFLOW,
-    ERR_UNKNOWN_ERROR
+    ERR_UNKNOWN_ERROR,
+    ERR_ARITHMETIC_OVERFLOW
+};
+
+// Where a run stopped on a fault: the code and the faulting instruction.
+struct ErrorRegister {
+    ExecutionError code = ERR_NONE;
+    size_t pc = 0;
+
+    explicit operator bool() const {
+        return code != ERR_NONE;
+    }
+};
+
+// Fixed-size int storage split into copy-on-write pages. Copying a CowPages
+// (a snapshot) shares every page and costs PageCount pointer copies whatever
+// the contents; the first write to a shared page copies just that page.
+// Assigning one CowPages to another never allocates.
+//
+// Pages never written are null and read from one static zero page. `owned`
+// marks pages this copy may write in place (a copy clears it on both sides);
+// `touched` marks pages that may hold non-zero values, so clear() is
+// O(touched pages) and keeps owned pages for reuse.
+template <size_t PageCount, size_t PageSize>
+class CowPages {
+public:
+    static_assert(PageCount >= 1 && PageCount <= 64, "page masks are 64 bits wide");
+
+    struct Page {
+        std::array<int, PageSize> values{};
+    };
+
+    CowPages() {
+        raw.fill(zeroPage());
+    }
+
+    CowPages(const CowPages& other) : pages(other.pages), raw(other.raw), touched(other.touched) {
+        other.disown();
+    }
+
+    CowPages& operator=(const CowPages& other) {
+        if (this != &other) {
+            pages = other.pages;
+            raw = other.raw;
+            touched = other.touched;
+            owned = 0;
+            other.disown();
+        }
+        return *this;
+    }
+
+    int read(size_t index) const {
+        return raw[index / PageSize]->values[index % PageSize];
+    }
+
+    void write(size_t index, int value) {
+        const size_t page = index / PageSize;
+        const uint64_t bit = uint64_t(1) << page;
+        if (!(owned & bit)) {
+            own(page);
+        }
+        touched |= bit;
+        raw[page]->values[index % PageSize] = value;
+    }
+
+    void clear() {
+        for (size_t page = 0; page < PageCount && (touched >> page) != 0; ++page) {
+            if (!((touched >> page) & 1)) {
+                continue;
+            }
+            if ((owned >> page) & 1) {
+                raw[page]->values.fill(0);
+            } else {
+                pages[page].reset();
+                raw[page] = zeroPage();
+            }
+        }
+        touched = 0;
+    }
+
+    size_t touchedPages() const {
+        size_t count = 0;
+        for (uint64_t mask = touched; mask != 0; mask &= mask - 1) {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    static Page* zeroPage() {
+        static Page page;
+        return &page;
+    }
+
+    // A snapshot is never written, so its `owned` is already zero and shared
+    // snapshots are only ever read from other threads.
+    void disown() const {
+        if (owned) owned = 0;
+    }
+
+    void own(size_t page) {
+        if (!pages[page]) {
+            pages[page] = std::make_shared<Page>();
+        } else if (pages[page].use_count() != 1) {
+            pages[page] = std::make_shared<Page>(*pages[page]);
+        }
+        raw[page] = pages[page].get();
+        owned |= uint64_t(1) << page;
+    }
+
+    std::array<std::shared_ptr<Page>, PageCount> pages;  // null: all zeroes
+    std::array<Page*, PageCount> raw;                    // pages[i].get(), or the zero page
+    uint64_t touched = 0;
+    mutable uint64_t owned = 0;
 };
 
-// Memory management class (simulating virtual memory)
+// Memory management class (simulating virtual memory). Bounds handling comes
+// from the access policy; see src/memory/access_policy.h. Storage is
+// copy-on-write, so copying a VirtualMemory is a cheap snapshot.
+template <typename AccessPolicy = execue::CheckedAccess>
 class VirtualMemory {
 public:
-    VirtualMemory() : memory(MEMORY_SIZE, 0) {}
+    static constexpr size_t PAGE_COUNT = 64;
+    static constexpr size_t PAGE_SIZE = MEMORY_SIZE / PAGE_COUNT;
+    static_assert(MEMORY_SIZE % PAGE_COUNT == 0, "MEMORY_SIZE must split into 64 pages");
 
     void write(size_t address, int value) {
-        if (address >= MEMORY_SIZE) {
-            throw std::out_of_range("Memory address out of range");
+        if (AccessPolicy::admit(address, MEMORY_SIZE, fault)) {
+            memory.write(address, value);
         }
-        memory[address] = value;
     }
 
     int read(size_t address) {
-        if (address >= MEMORY_SIZE) {
-            throw std::out_of_range("Memory address out of range");
-        }
-        return memory[address];
+        return AccessPolicy::admit(address, MEMORY_SIZE, fault) ? memory.read(address) : 0;
+    }
+
+    // Only ever raised under ErrorRegisterAccess.
+    bool faulted() const {
+        return fault;
+    }
+
+    void clearFault() {
+        fault = false;
+    }
+
+    // Back to all zeroes in O(touched pages).
+    void clear() {
+        memory.clear();
+        fault = false;
+    }
+
+    size_t dirtyPageCount() const {
+        return memory.touchedPages();
     }
 
 private:
-    std::vector<int> memory;
+    CowPages<PAGE_COUNT, PAGE_SIZE> memory;
+    bool fault = false;
 };
 
 // The Instruction class represents the individual actions to be performed during execution
@@ -54,48 +197,266 @@ public:
 
     Instruction(const std::string& opcode, const std::vector<int>& operands)
         : opcode(opcode), operands(operands) {}
+};
+
+// Rejected at load time; `index` is the offending instruction.
+class ProgramLoadError : public std::runtime_error {
+public:
+    ProgramLoadError(ExecutionError code, size_t index, const std::string& message)
+        : std::runtime_error("instruction " + std::to_string(index) + ": " + message), code(code), index(index) {}
+
+    ExecutionError code;
+    size_t index;
+};
+
+// OVERFLOW_TRAP is never written by hand: decodeProgram substitutes it for
+// constant arithmetic that overflows when strictArithmetic is off.
+enum class Opcode : uint8_t { ADD, SUB, MUL, DIV, LOAD, STORE, HALT, OVERFLOW_TRAP };
+
+// Load-time form of an Instruction: enum opcode and inline operands, so the
+// run loop neither compares strings nor follows an operand vector.
+struct DecodedInstruction {
+    Opcode opcode;
+    int32_t a;
+    int32_t b;
+};
+
+struct DecodedProgram {
+    std::vector<DecodedInstruction> instructions;
+    bool addressesVerified = true;   // every LOAD/STORE address is inside memory
+    bool arithmeticVerified = true;  // no OVERFLOW_TRAP was substituted
+};
 
-    void execute(class ExecEngine& engine);
+struct LoadOptions {
+    // Reject out-of-range addresses at load. When false such programs load,
+    // and run under `faults` instead of the unchecked fast path.
+    bool strictAddresses = true;
+    // Reject overflowing constant arithmetic at load. When false such
+    // instructions load and fault with ERR_ARITHMETIC_OVERFLOW when reached.
+    bool strictArithmetic = true;
+    execue::MemoryAccess faults = execue::MemoryAccess::CHECKED;
 };
 
-// Execution Engine: Core of the virtual machine
-class ExecEngine {
+// Result of a constant ADD/SUB/MUL/DIV, computed wide enough that it cannot
+// overflow itself; callers check it fits in an int.
+inline int64_t wideResult(Opcode opcode, int32_t a, int32_t b) {
+    switch (opcode) {
+        case Opcode::ADD: return int64_t{ a } + b;
+        case Opcode::SUB: return int64_t{ a } - b;
+        case Opcode::MUL: return int64_t{ a } * b;
+        case Opcode::DIV: return int64_t{ a } / b;
+        default: return 0;
+    }
+}
+
+inline bool fitsInt(int64_t value) {
+    return value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max();
+}
+
+// Translates and validates a program: opcode names, operand counts, memory
+// addresses, constant divisors and constant arithmetic (which must not
+// overflow an int, INT_MIN / -1 included) are all checked here, once.
+inline DecodedProgram decodeProgram(const std::vector<Instruction>& program, bool strictAddresses = true,
+                                    bool strictArithmetic = true) {
+    struct Spec {
+        const char* name;
+        Opcode opcode;
+        size_t operands;
+    };
+    static const Spec specs[] = {
+        { "ADD", Opcode::ADD, 2 }, { "SUB", Opcode::SUB, 2 }, { "MUL", Opcode::MUL, 2 },
+        { "DIV", Opcode::DIV, 2 }, { "LOAD", Opcode::LOAD, 1 }, { "STORE", Opcode::STORE, 2 },
+        { "HALT", Opcode::HALT, 0 },
+    };
+
+    DecodedProgram decoded;
+    decoded.instructions.reserve(program.size());
+    for (size_t i = 0; i < program.size(); ++i) {
+        const Instruction& instruction = program[i];
+        const Spec* spec = nullptr;
+        for (const Spec& candidate : specs) {
+            if (instruction.opcode == candidate.name) {
+                spec = &candidate;
+                break;
+            }
+        }
+        if (!spec) {
+            throw ProgramLoadError(ERR_INVALID_OPCODE, i, "unknown opcode " + instruction.opcode);
+        }
+        if (instruction.operands.size() != spec->operands) {
+            throw ProgramLoadError(ERR_INVALID_OPCODE, i, instruction.opcode + " expects " + std::to_string(spec->operands) +
+                                   " operand(s), got " + std::to_string(instruction.operands.size()));
+        }
+
+        DecodedInstruction out{ spec->opcode, 0, 0 };
+        if (spec->operands > 0) out.a = instruction.operands[0];
+        if (spec->operands > 1) out.b = instruction.operands[1];
+        if ((out.opcode == Opcode::LOAD || out.opcode == Opcode::STORE) &&
+            (out.a < 0 || static_cast<size_t>(out.a) >= MEMORY_SIZE)) {
+            if (strictAddresses) {
+                throw ProgramLoadError(ERR_MEMORY_OVERFLOW, i, "address " + std::to_string(out.a) + " out of range");
+            }
+            decoded.addressesVerified = false;
+        }
+        if (out.opcode == Opcode::DIV && out.b == 0) {
+            throw ProgramLoadError(ERR_DIVIDE_BY_ZERO, i, "division by zero");
+        }
+        const bool arithmetic = out.opcode == Opcode::ADD || out.opcode == Opcode::SUB ||
+                                out.opcode == Opcode::MUL || out.opcode == Opcode::DIV;
+        if (arithmetic && !fitsInt(wideResult(out.opcode, out.a, out.b))) {
+            if (!strictArithmetic) {
+                decoded.instructions.push_back(DecodedInstruction{ Opcode::OVERFLOW_TRAP, 0, 0 });
+                decoded.arithmeticVerified = false;
+                continue;
+            }
+            throw ProgramLoadError(ERR_ARITHMETIC_OVERFLOW, i, instruction.opcode + " " + std::to_string(out.a) + ", " +
+                                   std::to_string(out.b) + " overflows int");
+        }
+        decoded.instructions.push_back(out);
+    }
+    return decoded;
+}
+
+// Execution Engine: Core of the virtual machine, specialised on how its memory
+// checks addresses.
+template <typename AccessPolicy>
+class BasicExecEngine {
 public:
-    ExecEngine() : stack(STACK_SIZE), memory(std::make_unique<VirtualMemory>()), programCounter(0), running(true) {}
+    using Stack = CowPages<STACK_SIZE / 16, 16>;
+    static_assert(STACK_SIZE % 16 == 0 && STACK_SIZE / 16 <= 64, "STACK_SIZE must split into at most 64 pages");
 
+    // Complete engine state at one point. Taking one copies page tables, not
+    // pages; engines and snapshots then share pages until one side writes.
+    // A snapshot is immutable and may be shared between threads.
+    struct Snapshot {
+        std::shared_ptr<const DecodedProgram> program;
+        size_t programCounter;
+        bool running;
+        size_t stackPointer;
+        ErrorRegister error;
+        Stack stack;
+        VirtualMemory<AccessPolicy> memory;
+    };
+
+    BasicExecEngine() : programCounter(0), running(true), memory(std::make_unique<VirtualMemory<AccessPolicy>>()) {}
+
+    // Fork: a new engine starting from `from`, sharing its pages.
+    explicit BasicExecEngine(const Snapshot& from) : BasicExecEngine() {
+        restore(from);
+    }
+
+    Snapshot snapshot() const {
+        return Snapshot{ loaded, programCounter, running, stackPointer, error, stack, *memory };
+    }
+
+    // Returns to `from` without allocating; pages are re-shared, and copied
+    // again only when written.
+    void restore(const Snapshot& from) {
+        loaded = from.program;
+        code = loaded ? loaded->instructions.data() : nullptr;
+        codeSize = loaded ? loaded->instructions.size() : 0;
+        programCounter = from.programCounter;
+        running = from.running;
+        stackPointer = from.stackPointer;
+        error = from.error;
+        stack = from.stack;
+        *memory = from.memory;
+    }
+
+    // Throws ProgramLoadError for malformed programs; the previously loaded
+    // program is kept in that case.
     void loadProgram(const std::vector<Instruction>& program) {
-        instructions = program;
+        loadProgram(std::make_shared<const DecodedProgram>(decodeProgram(program)));
+    }
+
+    // Shares the decoded program; nothing is copied.
+    void loadProgram(std::shared_ptr<const DecodedProgram> program) {
+        if (AccessPolicy::kind == execue::MemoryAccess::UNCHECKED && !program->addressesVerified) {
+            throw std::logic_error("Unchecked memory access needs a program with verified addresses");
+        }
+        loaded = std::move(program);
+        code = loaded->instructions.data();
+        codeSize = loaded->instructions.size();
+        reset();
     }
 
+    // Returns the engine to its just-constructed state, program unloaded, in
+    // time proportional to what the last run touched. Used by EnginePool.
+    void recycle() {
+        loaded.reset();
+        code = nullptr;
+        codeSize = 0;
+        reset();
+        memory->clear();
+    }
+
+    // Rewinds the loaded program; memory contents are kept.
+    void reset() {
+        programCounter = 0;
+        running = true;
+        stackPointer = 0;
+        error = ErrorRegister();
+        memory->clearFault();
+    }
+
+    // Stops at the first fault and leaves it in the error register. Under
+    // ErrorRegisterAccess instructions raise the register themselves and the
+    // loop tests it once per instruction; the other policies throw, and the
+    // exception is translated here.
     void run() {
-        while (running && programCounter < instructions.size()) {
-            const Instruction& instruction = instructions[programCounter];
+        if constexpr (AccessPolicy::records_faults) {
+            while (running && programCounter < codeSize) {
+                execute(code[programCounter]);
+                if (error) break;
+                programCounter++;
+            }
+        } else {
             try {
-                instruction.execute(*this);  // Execute the current instruction
-            } catch (const std::exception& e) {
-                std::cerr << "Execution Error: " << e.what() << std::endl;
-                break;
+                while (running && programCounter < codeSize) {
+                    execute(code[programCounter]);
+                    programCounter++;
+                }
+            } catch (const std::out_of_range&) {
+                raise(ERR_MEMORY_OVERFLOW);
+            } catch (const std::overflow_error&) {
+                raise(ERR_STACK_OVERFLOW);
+            } catch (const std::range_error&) {
+                raise(ERR_ARITHMETIC_OVERFLOW);
+            } catch (const std::exception&) {
+                raise(ERR_UNKNOWN_ERROR);
             }
-            programCounter++;
         }
     }
 
+    // Empty unless the last run stopped on a fault.
+    const ErrorRegister& errorRegister() const {
+        return error;
+    }
+
+    size_t stackDepth() const {
+        return stackPointer;
+    }
+
     void halt() {
         running = false;
     }
 
     void pushStack(int value) {
         if (stackPointer >= STACK_SIZE) {
+            if constexpr (AccessPolicy::records_faults) {
+                raise(ERR_STACK_OVERFLOW);
+                return;
+            }
             throw std::overflow_error("Stack Overflow");
         }
-        stack[stackPointer++] = value;
+        stack.write(stackPointer++, value);
     }
 
     int popStack() {
         if (stackPointer == 0) {
             throw std::underflow_error("Stack Underflow");
         }
-        return stack[--stackPointer];
+        return stack.read(--stackPointer);
     }
 
     int readMemory(size_t address) {
@@ -107,64 +468,157 @@ public:
     }
 
 private:
-    std::vector<Instruction> instructions;
+    void raise(ExecutionError code) {
+        error = ErrorRegister{ code, programCounter };
+    }
+
+    // Opcodes and divisors were validated by decodeProgram. The stack can
+    // still fail, and so can addresses and arithmetic of programs loaded
+    // without strictAddresses or strictArithmetic.
+    void execute(const DecodedInstruction& instruction) {
+        switch (instruction.opcode) {
+            case Opcode::ADD: pushStack(instruction.a + instruction.b); break;
+            case Opcode::SUB: pushStack(instruction.a - instruction.b); break;
+            case Opcode::MUL: pushStack(instruction.a * instruction.b); break;
+            case Opcode::DIV: pushStack(instruction.a / instruction.b); break;
+            case Opcode::LOAD: {
+                const int value = readMemory(instruction.a);
+                if (memoryFaulted()) break;
+                pushStack(value);
+                break;
+            }
+            case Opcode::STORE:
+                writeMemory(instruction.a, instruction.b);
+                memoryFaulted();
+                break;
+            case Opcode::HALT: halt(); break;
+            case Opcode::OVERFLOW_TRAP:
+                if constexpr (AccessPolicy::records_faults) {
+                    raise(ERR_ARITHMETIC_OVERFLOW);
+                    break;
+                }
+                throw std::range_error("Arithmetic overflow");
+        }
+    }
+
+    // Moves a refused access into the error register; always false for
+    // policies that throw instead.
+    bool memoryFaulted() {
+        if constexpr (AccessPolicy::records_faults) {
+            if (memory->faulted()) {
+                raise(ERR_MEMORY_OVERFLOW);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::shared_ptr<const DecodedProgram> loaded;
+    const DecodedInstruction* code = nullptr;
+    size_t codeSize = 0;
     size_t programCounter;
     bool running;
-    std::vector<int> stack;
+    Stack stack;
     size_t stackPointer = 0;
-    std::unique_ptr<VirtualMemory> memory;
+    std::unique_ptr<VirtualMemory<AccessPolicy>> memory;
+    ErrorRegister error;
 };
 
-// Executor for individual instructions
-void Instruction::execute(ExecEngine& engine) {
-    if (opcode == "ADD") {
-        int operand1 = operands[0];
-        int operand2 = operands[1];
-        engine.pushStack(operand1 + operand2);  // Perform addition and push result
-    }
-    else if (opcode == "SUB") {
-        int operand1 = operands[0];
-        int operand2 = operands[1];
-        engine.pushStack(operand1 - operand2);  // Perform subtraction and push result
-    }
-    else if (opcode == "MUL") {
-        int operand1 = operands[0];
-        int operand2 = operands[1];
-        engine.pushStack(operand1 * operand2);  // Perform multiplication and push result
-    }
-    else if (opcode == "DIV") {
-        int operand1 = operands[0];
-        int operand2 = operands[1];
-        if (operand2 == 0) {
-            throw std::runtime_error("Division by zero");
+using ExecEngine = BasicExecEngine<execue::CheckedAccess>;
+
+// Reusable engines for one access policy. acquire() hands out an idle engine
+// (or builds one); dropping the lease recycles it and puts it back. Safe to
+// use from several threads; the pool must outlive its leases.
+template <typename AccessPolicy>
+class EnginePool {
+public:
+    using Engine = BasicExecEngine<AccessPolicy>;
+
+    struct Release {
+        EnginePool* pool;
+        void operator()(Engine* engine) const { pool->release(engine); }
+    };
+    using Lease = std::unique_ptr<Engine, Release>;
+
+    Lease acquire() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (!idle.empty()) {
+                Engine* engine = idle.back().release();
+                idle.pop_back();
+                return Lease(engine, Release{ this });
+            }
+            ++created;
         }
-        engine.pushStack(operand1 / operand2);  // Perform division and push result
+        return Lease(new Engine(), Release{ this });
     }
-    else if (opcode == "LOAD") {
-        int address = operands[0];
-        engine.pushStack(engine.readMemory(address));  // Load value from memory to stack
-    }
-    else if (opcode == "STORE") {
-        int address = operands[0];
-        int value = operands[1];
-        engine.writeMemory(address, value);  // Store value into memory
+
+    size_t idleCount() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return idle.size();
     }
-    else if (opcode == "HALT") {
-        engine.halt();  // Halting the program
+
+    size_t createdCount() const {
+        std::lock_guard<std::mutex> guard(lock);
+        return created;
     }
-    else {
-        throw std::runtime_error("Unknown opcode: " + opcode);  // Invalid opcode
+
+private:
+    void release(Engine* engine) {
+        std::unique_ptr<Engine> owned(engine);
+        owned->recycle();
+        std::lock_guard<std::mutex> guard(lock);
+        idle.push_back(std::move(owned));
     }
-}
+
+    mutable std::mutex lock;
+    std::vector<std::unique_ptr<Engine>> idle;
+    size_t created = 0;
+};
 
 // Execution management class
 class ExecutionManager {
 public:
-    void executeProgram(const std::vector<Instruction>& program) {
-        ExecEngine engine;
-        engine.loadProgram(program);
-        engine.run();
+    // Fully verified programs run unchecked; the rest under options.faults, so
+    // their faults are reported the way the caller asked.
+    static execue::MemoryAccess choosePolicy(const DecodedProgram& program, const LoadOptions& options) {
+        return program.addressesVerified && program.arithmeticVerified ? execue::MemoryAccess::UNCHECKED : options.faults;
+    }
+
+    // Decodes once; the result can be executed any number of times.
+    static std::shared_ptr<const DecodedProgram> prepare(const std::vector<Instruction>& program,
+                                                         const LoadOptions& options = LoadOptions()) {
+        return std::make_shared<const DecodedProgram>(decodeProgram(program, options.strictAddresses, options.strictArithmetic));
+    }
+
+    // Returns the engine's error register: empty unless the run faulted.
+    ErrorRegister executeProgram(const std::vector<Instruction>& program, const LoadOptions& options = LoadOptions()) {
+        return executeProgram(prepare(program, options), options);
     }
+
+    // Runs a shared program on a pooled engine.
+    ErrorRegister executeProgram(const std::shared_ptr<const DecodedProgram>& program,
+                                  const LoadOptions& options = LoadOptions()) {
+        switch (choosePolicy(*program, options)) {
+            case execue::MemoryAccess::UNCHECKED: return runWith(uncheckedEngines, program);
+            case execue::MemoryAccess::ERROR_REGISTER: return runWith(errorRegisterEngines, program);
+            case execue::MemoryAccess::CHECKED: break;
+        }
+        return runWith(checkedEngines, program);
+    }
+
+private:
+    template <typename AccessPolicy>
+    static ErrorRegister runWith(EnginePool<AccessPolicy>& pool, const std::shared_ptr<const DecodedProgram>& program) {
+        auto engine = pool.acquire();
+        engine->loadProgram(program);
+        engine->run();
+        return engine->errorRegister();
+    }
+
+    EnginePool<execue::CheckedAccess> checkedEngines;
+    EnginePool<execue::ErrorRegisterAccess> errorRegisterEngines;
+    EnginePool<execue::UncheckedAccess> uncheckedEngines;
 };
 
 // ErrorLogger class for managing runtime errors
@@ -175,8 +629,144 @@ public:
     }
 };
 
+// Memory-heavy straight-line program: 512 STOREs then 511 LOADs (the stack
+// holds 512), touching addresses across the whole memory.
+static std::vector<Instruction> memoryBenchProgram() {
+    std::vector<Instruction> program;
+    for (int i = 0; i < 512; ++i) {
+        program.emplace_back("STORE", std::vector<int>{ (i * 7) % static_cast<int>(MEMORY_SIZE), i });
+    }
+    for (int i = 0; i < 511; ++i) {
+        program.emplace_back("LOAD", std::vector<int>{ (i * 13) % static_cast<int>(MEMORY_SIZE) });
+    }
+    program.emplace_back("HALT", std::vector<int>{});
+    return program;
+}
+
+template <typename AccessPolicy>
+static void benchPolicy(const std::shared_ptr<const DecodedProgram>& program, int runs) {
+    BasicExecEngine<AccessPolicy> engine;
+    engine.loadProgram(program);
+    const auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; ++run) {
+        engine.reset();
+        engine.run();
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    const double accesses = static_cast<double>(runs) * (program->instructions.size() - 1);
+    std::cout << "[BENCH] " << execue::memoryAccessName(AccessPolicy::kind) << ": "
+              << elapsed.count() / accesses << " ns/access (stack depth " << engine.stackDepth() << ")" << std::endl;
+}
+
+// Many short programs: a fresh engine per call (what executeProgram used to
+// do) against the manager's pooled engines.
+static void benchShortPrograms(const std::vector<Instruction>& source, int runs) {
+    const auto program = ExecutionManager::prepare(source);
+    const auto fresh = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; ++run) {
+        BasicExecEngine<execue::UncheckedAccess> engine;
+        engine.loadProgram(program);
+        engine.run();
+    }
+    const std::chrono::duration<double, std::nano> freshNs = std::chrono::steady_clock::now() - fresh;
+
+    ExecutionManager manager;
+    const auto pooled = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; ++run) {
+        manager.executeProgram(program);
+    }
+    const std::chrono::duration<double, std::nano> pooledNs = std::chrono::steady_clock::now() - pooled;
+
+    std::cout << "[BENCH] short program x" << runs << ": fresh engine " << freshNs.count() / runs
+              << " ns/run, pooled " << pooledNs.count() / runs << " ns/run" << std::endl;
+}
+
+// What-if runs from a warmed-up state: snapshot once, then restore and run
+// the memory-heavy program again, so every run rewrites shared pages.
+static void benchSnapshots(const std::shared_ptr<const DecodedProgram>& program, int runs) {
+    BasicExecEngine<execue::UncheckedAccess> engine;
+    engine.loadProgram(program);
+    engine.run();
+    engine.reset();
+
+    const auto taking = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; ++run) {
+        auto snapshot = engine.snapshot();
+        (void)snapshot;
+    }
+    const std::chrono::duration<double, std::nano> takeNs = std::chrono::steady_clock::now() - taking;
+
+    const auto warm = engine.snapshot();
+    const auto restoring = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; ++run) {
+        engine.restore(warm);
+        engine.run();
+    }
+    const std::chrono::duration<double, std::nano> restoreNs = std::chrono::steady_clock::now() - restoring;
+
+    std::cout << "[BENCH] snapshot: " << takeNs.count() / runs << " ns; restore + run: "
+              << restoreNs.count() / runs << " ns/run" << std::endl;
+}
+
+// Fault-free against faulting runs of the same short program, with faults
+// thrown and caught (checked) or left in the error register. One faulting
+// copy loads from past the end of memory, the other divides INT_MIN by -1;
+// all are decoded without strictAddresses and strictArithmetic.
+template <typename AccessPolicy>
+static double benchFaultRuns(const std::shared_ptr<const DecodedProgram>& program, int runs) {
+    BasicExecEngine<AccessPolicy> engine;
+    engine.loadProgram(program);
+    int faults = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < runs; ++run) {
+        engine.reset();
+        engine.run();
+        faults += static_cast<bool>(engine.errorRegister());
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (faults != 0 && faults != runs) std::cerr << "[BENCH] inconsistent fault count " << faults << std::endl;
+    return elapsed.count() / runs;
+}
+
+static void benchFaults(std::vector<Instruction> source, int runs) {
+    LoadOptions lenient;
+    lenient.strictAddresses = false;
+    lenient.strictArithmetic = false;
+    const auto clean = ExecutionManager::prepare(source, lenient);
+    std::vector<Instruction> badAddress = source;
+    std::vector<Instruction> badDivide = source;
+    for (size_t i = 0; i < source.size(); ++i) {
+        if (source[i].opcode == "LOAD") badAddress[i].operands[0] = static_cast<int>(MEMORY_SIZE) + 1;
+        if (source[i].opcode == "DIV") badDivide[i].operands = { std::numeric_limits<int>::min(), -1 };
+    }
+    const auto addressFault = ExecutionManager::prepare(badAddress, lenient);
+    const auto divideFault = ExecutionManager::prepare(badDivide, lenient);
+
+    const double checkedClean = benchFaultRuns<execue::CheckedAccess>(clean, runs);
+    const double checkedAddress = benchFaultRuns<execue::CheckedAccess>(addressFault, runs);
+    const double checkedDivide = benchFaultRuns<execue::CheckedAccess>(divideFault, runs);
+    const double registerClean = benchFaultRuns<execue::ErrorRegisterAccess>(clean, runs);
+    const double registerAddress = benchFaultRuns<execue::ErrorRegisterAccess>(addressFault, runs);
+    const double registerDivide = benchFaultRuns<execue::ErrorRegisterAccess>(divideFault, runs);
+    std::cout << "[BENCH] faults x" << runs << " (ns/run clean, bad address, INT_MIN / -1): checked "
+              << checkedClean << ", " << checkedAddress << ", " << checkedDivide << "; error-register "
+              << registerClean << ", " << registerAddress << ", " << registerDivide << std::endl;
+}
+
+static int runMemoryBenchmark(int runs, const std::vector<Instruction>& shortProgram) {
+    const auto program = ExecutionManager::prepare(memoryBenchProgram());
+    std::cout << "[BENCH] " << runs << " runs of " << program->instructions.size() << " instructions" << std::endl;
+    benchPolicy<execue::CheckedAccess>(program, runs);
+    benchPolicy<execue::ErrorRegisterAccess>(program, runs);
+    benchPolicy<execue::UncheckedAccess>(program, runs);
+    benchSnapshots(program, runs);
+    benchShortPrograms(shortProgram, runs * 50);
+    benchFaults(shortProgram, runs * 50);
+    return 0;
+}
+
 // Example program to be executed
-int main() {
+int main(int argc, char** argv) {
     std::vector<Instruction> program = {
         Instruction("ADD", {5, 3}),
         Instruction("SUB", {10, 4}),
@@ -187,9 +777,18 @@ int main() {
         Instruction("HALT", {})
     };
 
+    if (argc > 1 && std::strncmp(argv[1], "--bench", 7) == 0) {
+        return runMemoryBenchmark(argv[1][7] == '=' ? std::max(1, std::atoi(argv[1] + 8)) : 20000, program);
+    }
+
     ExecutionManager execMgr;
     try {
-        execMgr.executeProgram(program);
+        const ErrorRegister fault = execMgr.executeProgram(program);
+        if (fault) {
+            ErrorLogger::logExecutionError(fault.code, "execution stopped at instruction " + std::to_string(fault.pc));
+        }
+    } catch (const ProgramLoadError& e) {
+        ErrorLogger::logExecutionError(e.code, e.what());
     } catch (const std::exception& e) {
         ErrorLogger::logExecutionError(ERR_UNKNOWN_ERROR, e.what());
     }
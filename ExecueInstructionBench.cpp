@@ -0,0 +1,237 @@
+// EXECUE+ Instruction Dispatch Microbenchmark
+// Compares InstructionSet and the static InstructionTable with the registry
+// they replaced: a hash map of std::function handlers that signalled HALT by
+// throwing.
+// Build: g++ -std=c++17 -O2 ExecueInstructionBench.cpp -o instruction_bench
+// Add -DEXECUE_PROFILE=1 for a per-opcode profile of the flat-table runs.
+// Usage: instruction_bench [dispatches] [programs]
+
+#include "ExecueInstructionSet.cpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+using namespace execue;
+using Clock = std::chrono::steady_clock;
+
+// The original registry: one hash lookup and one type-erased call per opcode.
+class MapInstructionSet {
+public:
+    void register_instruction(uint8_t opcode, const std::string& mnemonic, OpcodeType type,
+                              const std::function<void(ExecutionContext&)>& exec_func) {
+        instructions[opcode] = RegisteredOp{ mnemonic, type, exec_func };
+    }
+
+    void execute(uint8_t opcode, ExecutionContext& context) {
+        auto it = instructions.find(opcode);
+        if (it == instructions.end()) {
+            throw std::runtime_error("Illegal opcode");
+        }
+        it->second.exec(context);
+    }
+
+private:
+    struct RegisteredOp {
+        std::string mnemonic;
+        OpcodeType type;
+        std::function<void(ExecutionContext&)> exec;
+    };
+
+    std::unordered_map<uint8_t, RegisteredOp> instructions;
+};
+
+// Legacy handlers, as define_core_instructions used to register them.
+void legacy_load(ExecutionContext& ctx) {
+    ctx.registers[REG_A] = ctx.memory[ctx.program_counter + 1];
+    ctx.program_counter += 2;
+}
+
+void legacy_store(ExecutionContext& ctx) {
+    ctx.memory[ctx.program_counter + 1] = static_cast<uint8_t>(ctx.registers[REG_A]);
+    ctx.program_counter += 2;
+}
+
+void legacy_jmp(ExecutionContext& ctx) {
+    ctx.program_counter = ctx.memory[ctx.program_counter + 1];
+}
+
+void legacy_halt(ExecutionContext&) {
+    throw std::runtime_error("Execution Halted");
+}
+
+// NOP only advances the program counter, so the dispatch loop measures fetch
+// and dispatch rather than handler work.
+void legacy_nop(ExecutionContext& ctx) {
+    ctx.program_counter += 1;
+}
+
+struct NopOp {
+    static constexpr uint8_t code = 0x00;
+    static constexpr const char* mnemonic = "NOP";
+    static constexpr OpcodeType type = OpcodeType::CONTROL;
+    static constexpr uint8_t length = 1;
+    static constexpr bool falls_through = true;
+
+    static ExecStatus exec_unchecked(ExecutionContext& ctx) {
+        ctx.program_counter += 1;
+        return ExecStatus::next();
+    }
+
+    static ExecStatus exec(ExecutionContext& ctx) {
+        return exec_unchecked(ctx);
+    }
+};
+
+using BenchInstructions = InstructionTable<NopOp, LoadOp, StoreOp, JmpOp, HaltOp>;
+
+void define_legacy_instructions(MapInstructionSet& set) {
+    set.register_instruction(0x00, "NOP", OpcodeType::CONTROL, &legacy_nop);
+    set.register_instruction(0x01, "LOAD", OpcodeType::READ, &legacy_load);
+    set.register_instruction(0x02, "STORE", OpcodeType::WRITE, &legacy_store);
+    set.register_instruction(0x10, "JMP", OpcodeType::JUMP, &legacy_jmp);
+    set.register_instruction(0xFF, "HALT", OpcodeType::CONTROL, &legacy_halt);
+}
+
+double nanos_per(Clock::time_point start, uint64_t count) {
+    const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+    return elapsed.count() / static_cast<double>(count);
+}
+
+// Memory image: 62 NOPs, then JMP 0.
+ExecutionContext make_loop() {
+    ExecutionContext ctx{};
+    ctx.memory.assign(64, 0x00);
+    ctx.memory[62] = 0x10;
+    ctx.memory[63] = 0x00;
+    return ctx;
+}
+
+// LOAD 5; STORE; HALT — a program that ends almost as soon as it starts.
+ExecutionContext make_short_program() {
+    ExecutionContext ctx{};
+    ctx.memory = { 0x01, 0x05, 0x02, 0x00, 0xFF };
+    return ctx;
+}
+
+double dispatch_legacy(MapInstructionSet& set, uint64_t dispatches) {
+    ExecutionContext ctx = make_loop();
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < dispatches; ++i) {
+        set.execute(ctx.memory[ctx.program_counter], ctx);
+    }
+    return nanos_per(start, dispatches);
+}
+
+double dispatch_table(const InstructionSet& set, uint64_t dispatches) {
+    ExecutionContext ctx = make_loop();
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < dispatches; ++i) {
+        set.execute(ctx.memory[ctx.program_counter], ctx);
+    }
+    return nanos_per(start, dispatches);
+}
+
+double dispatch_static(uint64_t dispatches) {
+    ExecutionContext ctx = make_loop();
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < dispatches; ++i) {
+        BenchInstructions::execute(ctx.memory[ctx.program_counter], ctx);
+    }
+    return nanos_per(start, dispatches);
+}
+
+// InstructionTable::run over the NOP/JMP loop, checked or verified.
+double run_static(uint64_t dispatches, bool verified) {
+    ExecutionContext ctx = make_loop();
+    if (verified && !BenchInstructions::verify(ctx).ok) {
+        std::cerr << "loop image failed verification" << std::endl;
+    }
+    const auto start = Clock::now();
+    BenchInstructions::run(ctx, dispatches);
+    return nanos_per(start, dispatches);
+}
+
+double programs_legacy(MapInstructionSet& set, uint64_t programs) {
+    ExecutionContext ctx = make_short_program();
+    uint64_t halted = 0;
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < programs; ++i) {
+        ctx.program_counter = 0;
+        try {
+            for (;;) {
+                set.execute(ctx.memory[ctx.program_counter], ctx);
+            }
+        } catch (const std::runtime_error&) {
+            ++halted;
+        }
+    }
+    const double ns = nanos_per(start, programs);
+    if (halted != programs) std::cerr << "legacy: " << programs - halted << " programs did not halt" << std::endl;
+    return ns;
+}
+
+double programs_table(const InstructionSet& set, uint64_t programs) {
+    ExecutionContext ctx = make_short_program();
+    uint64_t halted = 0;
+    const auto start = Clock::now();
+    for (uint64_t i = 0; i < programs; ++i) {
+        ctx.program_counter = 0;
+        halted += set.run(ctx).kind == ExecStatus::HALT;
+    }
+    const double ns = nanos_per(start, programs);
+    if (halted != programs) std::cerr << "table: " << programs - halted << " programs did not halt" << std::endl;
+    return ns;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint64_t dispatches = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000ULL;
+    const uint64_t programs = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000ULL;
+
+    InstructionSet table;
+    BenchInstructions::register_into(table);
+    table.freeze();
+
+    MapInstructionSet legacy;
+    define_legacy_instructions(legacy);
+
+    const double legacyDispatch = dispatch_legacy(legacy, dispatches);
+    const double tableDispatch = dispatch_table(table, dispatches);
+    const double staticDispatch = dispatch_static(dispatches);
+    std::cout << "[BENCH] dispatch, " << dispatches << " ops" << std::endl;
+    std::cout << "[BENCH]   unordered_map + std::function: " << legacyDispatch << " ns/op" << std::endl;
+    std::cout << "[BENCH]   flat table:                    " << tableDispatch << " ns/op ("
+              << legacyDispatch / tableDispatch << "x)" << std::endl;
+    std::cout << "[BENCH]   static InstructionTable:       " << staticDispatch << " ns/op ("
+              << legacyDispatch / staticDispatch << "x)" << std::endl;
+
+    const double checkedRun = run_static(dispatches, false);
+    const double verifiedRun = run_static(dispatches, true);
+    std::cout << "[BENCH] InstructionTable::run, " << dispatches << " ops" << std::endl;
+    std::cout << "[BENCH]   checked:  " << checkedRun << " ns/op" << std::endl;
+    std::cout << "[BENCH]   verified: " << verifiedRun << " ns/op (" << checkedRun / verifiedRun << "x)" << std::endl;
+
+    const double legacyPrograms = programs_legacy(legacy, programs);
+    const double tablePrograms = programs_table(table, programs);
+    std::cout << "[BENCH] short programs (LOAD, STORE, HALT), " << programs << " runs" << std::endl;
+    std::cout << "[BENCH]   HALT throws:         " << legacyPrograms << " ns/program" << std::endl;
+    std::cout << "[BENCH]   HALT returns status: " << tablePrograms << " ns/program ("
+              << legacyPrograms / tablePrograms << "x)" << std::endl;
+
+#if EXECUE_PROFILE
+    // Profiled rerun of both workloads; the timings above ran with no
+    // profiler attached.
+    OpcodeProfiler profiler;
+    table.attach_profiler(&profiler);
+    dispatch_table(table, dispatches / 100);
+    programs_table(table, programs / 100);
+    table.attach_profiler(nullptr);
+    std::cout << "[PROFILE]" << std::endl << profiler.to_table(table);
+    std::cout << profiler.to_json(table) << std::endl;
+#endif
+    return 0;
+}
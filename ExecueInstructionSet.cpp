@@ -5,11 +5,28 @@
 #ifndef EXECUE_INSTRUCTION_SET_H
 #define EXECUE_INSTRUCTION_SET_H
 
+#include <array>
 #include <cstdint>
+#include <cstdio>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <functional>
+#include <stdexcept>
+#include <chrono>
+
+// Build with -DEXECUE_PROFILE=1 to compile per-opcode profiling into
+// InstructionSet::execute. Left at 0, the dispatch path carries no trace of it.
+#ifndef EXECUE_PROFILE
+#define EXECUE_PROFILE 0
+#endif
+
+#if EXECUE_PROFILE && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define EXECUE_PROFILE_TSC 1
+#else
+#define EXECUE_PROFILE_TSC 0
+#endif
 
 namespace execue {
 
@@ -33,55 +50,791 @@ enum class OpcodeType {
     DEVICE
 };
 
+constexpr size_t OPCODE_TYPE_COUNT = static_cast<size_t>(OpcodeType::DEVICE) + 1;
+
+inline const char* opcode_type_name(OpcodeType type) {
+    static const char* const names[OPCODE_TYPE_COUNT] = {
+        "READ", "WRITE", "LOGIC", "JUMP", "DIAGNOSTIC", "CONTROL", "MEMORY", "DEVICE"
+    };
+    return names[static_cast<size_t>(type)];
+}
+
+// Register identifiers. Handlers and assembled operands use these ids; names
+// are resolved once, when an instruction is registered or assembled.
+enum RegisterId : uint8_t {
+    REG_A,
+    REG_B,
+    REG_C,
+    REG_D,
+    REG_X,
+    REG_Y,
+    REG_SP,
+    REG_FLAGS,
+    REGISTER_COUNT
+};
+
+inline const char* register_name(uint8_t id) {
+    static const char* const names[REGISTER_COUNT] = { "A", "B", "C", "D", "X", "Y", "SP", "FLAGS" };
+    return id < REGISTER_COUNT ? names[id] : "?";
+}
+
+// Name -> id, for assemblers and tooling. Throws on an unknown name.
+inline RegisterId resolve_register(const std::string& name) {
+    for (uint8_t id = 0; id < REGISTER_COUNT; ++id) {
+        if (name == register_name(id)) {
+            return static_cast<RegisterId>(id);
+        }
+    }
+    throw std::invalid_argument("Unknown register: " + name);
+}
+
+// Fixed-size register file indexed by RegisterId.
+struct RegisterFile {
+    std::array<int32_t, REGISTER_COUNT> values{};
+
+    int32_t& operator[](RegisterId id) { return values[id]; }
+    int32_t operator[](RegisterId id) const { return values[id]; }
+
+    // Debugging and inspection only: resolves the name on every call.
+    int32_t& named(const std::string& name) { return values[resolve_register(name)]; }
+    int32_t named(const std::string& name) const { return values[resolve_register(name)]; }
+
+    // "A=1 B=0 ..." for dumps and logs.
+    std::string describe() const {
+        std::string out;
+        for (uint8_t id = 0; id < REGISTER_COUNT; ++id) {
+            if (id) out += ' ';
+            out += register_name(id);
+            out += '=';
+            out += std::to_string(values[id]);
+        }
+        return out;
+    }
+};
+
+// Why a handler stopped the program.
+enum class FaultCode : uint8_t {
+    NONE,
+    ILLEGAL_OPCODE,
+    PC_OUT_OF_RANGE,
+    MEMORY_OUT_OF_RANGE,
+    STEP_LIMIT
+};
+
+// Handler result, returned in a register instead of thrown. CONTINUE and JUMP
+// both keep running (the handler has already moved the program counter); JUMP
+// only marks a taken branch. HALT and FAULT stop the dispatch loop with the
+// program counter left on the instruction that stopped it.
+struct ExecStatus {
+    enum Kind : uint8_t { CONTINUE, JUMP, HALT, FAULT };
+
+    Kind kind;
+    FaultCode fault;
+
+    static constexpr ExecStatus next() { return { CONTINUE, FaultCode::NONE }; }
+    static constexpr ExecStatus jump() { return { JUMP, FaultCode::NONE }; }
+    static constexpr ExecStatus halt() { return { HALT, FaultCode::NONE }; }
+    static constexpr ExecStatus failed(FaultCode code) { return { FAULT, code }; }
+
+    constexpr bool running() const { return kind <= JUMP; }
+};
+
+inline const char* fault_name(FaultCode code) {
+    switch (code) {
+        case FaultCode::NONE: return "none";
+        case FaultCode::ILLEGAL_OPCODE: return "illegal opcode";
+        case FaultCode::PC_OUT_OF_RANGE: return "program counter out of range";
+        case FaultCode::MEMORY_OUT_OF_RANGE: return "memory access out of range";
+        case FaultCode::STEP_LIMIT: return "step limit reached";
+    }
+    return "unknown";
+}
+
+// Whoever sets up an ExecutionContext interns the dominion names its program
+// uses; at run time the dominion stack and the log only move 32-bit handles.
+// No opcode here enters a dominion, so nothing in this file interns names.
+using DominionHandle = uint32_t;
+
+class DominionTable {
+public:
+    DominionHandle intern(const std::string& name) {
+        auto found = ids.find(name);
+        if (found != ids.end()) {
+            return found->second;
+        }
+        const DominionHandle handle = static_cast<DominionHandle>(names.size());
+        names.push_back(name);
+        ids.emplace(name, handle);
+        return handle;
+    }
+
+    bool lookup(const std::string& name, DominionHandle& handle) const {
+        auto found = ids.find(name);
+        if (found == ids.end()) {
+            return false;
+        }
+        handle = found->second;
+        return true;
+    }
+
+    const std::string& name(DominionHandle handle) const {
+        if (handle >= names.size()) {
+            throw std::out_of_range("Unknown dominion handle " + std::to_string(handle));
+        }
+        return names[handle];
+    }
+
+    size_t size() const {
+        return names.size();
+    }
+
+private:
+    std::unordered_map<std::string, DominionHandle> ids;
+    std::vector<std::string> names;
+};
+
+enum class LogCode : uint8_t {
+    NOTE,
+    DOMINION_ENTER,  // argument: DominionHandle
+    DOMINION_EXIT,   // argument: DominionHandle
+    HALT,
+    FAULT            // argument: FaultCode
+};
+
+inline const char* log_code_name(LogCode code) {
+    switch (code) {
+        case LogCode::NOTE: return "NOTE";
+        case LogCode::DOMINION_ENTER: return "DOMINION_ENTER";
+        case LogCode::DOMINION_EXIT: return "DOMINION_EXIT";
+        case LogCode::HALT: return "HALT";
+        case LogCode::FAULT: return "FAULT";
+    }
+    return "?";
+}
+
+struct LogEntry {
+    uint32_t pc;
+    uint8_t opcode;
+    LogCode code;
+    int32_t argument;
+};
+
+// Fixed-capacity ring of structured log entries. push() never allocates; once
+// full, the oldest entries are overwritten. Text is only produced by
+// format_log(), when someone actually reads the log.
+class LogRing {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    LogRing() : LogRing(DEFAULT_CAPACITY) {}
+    explicit LogRing(size_t capacity) : slots(capacity ? capacity : 1) {}
+
+    void push(uint8_t opcode, uint32_t pc, LogCode code, int32_t argument = 0) {
+        slots[next] = LogEntry{ pc, opcode, code, argument };
+        if (++next == slots.size()) next = 0;
+        ++written;
+    }
+
+    void clear() {
+        next = 0;
+        written = 0;
+    }
+
+    size_t capacity() const { return slots.size(); }
+    size_t size() const { return written < slots.size() ? static_cast<size_t>(written) : slots.size(); }
+    uint64_t dropped() const { return written - size(); }
+
+    // Oldest first.
+    const LogEntry& operator[](size_t index) const {
+        const size_t oldest = written < slots.size() ? 0 : next;
+        return slots[(oldest + index) % slots.size()];
+    }
+
+private:
+    std::vector<LogEntry> slots;
+    size_t next = 0;
+    uint64_t written = 0;
+};
+
 // Execution context
 struct ExecutionContext {
     uint32_t program_counter;
-    std::unordered_map<std::string, int32_t> registers;
+    RegisterFile registers;
     std::vector<uint8_t> memory;
-    std::vector<std::string> dominion_stack;
-    std::vector<std::string> log_stack;
+    DominionTable dominions;
+    std::vector<DominionHandle> dominion_stack;
+    LogRing log_stack;
+    // Set by InstructionTable::verify for the current memory image and entry
+    // point; clear it when replacing either.
+    bool verified = false;
+};
+
+// Records why a dispatch loop stopped. The opcode is the byte at the program
+// counter, or 0 when the counter is outside the image.
+inline void log_stop(ExecutionContext& ctx, ExecStatus status) {
+    const uint8_t opcode = ctx.program_counter < ctx.memory.size() ? ctx.memory[ctx.program_counter] : 0;
+    if (status.kind == ExecStatus::HALT) {
+        ctx.log_stack.push(opcode, ctx.program_counter, LogCode::HALT);
+    } else {
+        ctx.log_stack.push(opcode, ctx.program_counter, LogCode::FAULT, static_cast<int32_t>(status.fault));
+    }
+}
+
+// Renders the log, oldest first: "0004 LOAD FAULT memory access out of range".
+// `mnemonic` maps an opcode byte to its name, e.g. CoreInstructions::mnemonic
+// or a lambda over InstructionSet::get_mnemonic.
+template <typename MnemonicFn>
+std::vector<std::string> format_log(const ExecutionContext& ctx, MnemonicFn mnemonic) {
+    std::vector<std::string> lines;
+    lines.reserve(ctx.log_stack.size());
+    for (size_t i = 0; i < ctx.log_stack.size(); ++i) {
+        const LogEntry& entry = ctx.log_stack[i];
+        char pc[16];
+        std::snprintf(pc, sizeof(pc), "%04x ", entry.pc);
+        std::string line = pc;
+        line += mnemonic(entry.opcode);
+        line += ' ';
+        line += log_code_name(entry.code);
+        switch (entry.code) {
+            case LogCode::DOMINION_ENTER:
+            case LogCode::DOMINION_EXIT:
+                line += ' ' + ctx.dominions.name(static_cast<DominionHandle>(entry.argument));
+                break;
+            case LogCode::FAULT:
+                line += ' ';
+                line += fault_name(static_cast<FaultCode>(entry.argument));
+                break;
+            case LogCode::NOTE:
+                line += ' ' + std::to_string(entry.argument);
+                break;
+            case LogCode::HALT:
+                break;
+        }
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
+class InstructionSet;
+
+// Execution counts and cost per opcode and per OpcodeType, plus taken and
+// not-taken counts for JUMP-type instructions. Cost is in TSC cycles on x86
+// and steady_clock nanoseconds elsewhere, and includes the timer reads.
+class OpcodeProfiler {
+public:
+    struct Counter {
+        uint64_t count = 0;
+        uint64_t cost = 0;
+    };
+
+    static uint64_t now() {
+#if EXECUE_PROFILE_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static const char* unit() {
+        return EXECUE_PROFILE_TSC ? "cycles" : "ns";
+    }
+
+    // A JUMP-type instruction that returns CONTINUE fell through.
+    void record(uint8_t opcode, OpcodeType type, uint64_t cost, ExecStatus status) {
+        Counter& op = opcodes[opcode];
+        ++op.count;
+        op.cost += cost;
+        Counter& category = categories[static_cast<size_t>(type)];
+        ++category.count;
+        category.cost += cost;
+        if (status.kind == ExecStatus::JUMP) {
+            ++jumps_taken;
+        } else if (type == OpcodeType::JUMP && status.kind == ExecStatus::CONTINUE) {
+            ++jumps_not_taken;
+        }
+    }
+
+    void reset() {
+        *this = OpcodeProfiler();
+    }
+
+    const Counter& opcode(uint8_t code) const { return opcodes[code]; }
+    const Counter& category(OpcodeType type) const { return categories[static_cast<size_t>(type)]; }
+    uint64_t taken() const { return jumps_taken; }
+    uint64_t not_taken() const { return jumps_not_taken; }
+
+    Counter total() const {
+        Counter sum;
+        for (const Counter& op : opcodes) {
+            sum.count += op.count;
+            sum.cost += op.cost;
+        }
+        return sum;
+    }
+
+    // Mnemonics come from the set that was profiled; opcodes that never ran
+    // are omitted.
+    std::string to_json(const InstructionSet& set) const;
+    std::string to_table(const InstructionSet& set) const;
+
+private:
+    std::array<Counter, 256> opcodes{};
+    std::array<Counter, OPCODE_TYPE_COUNT> categories{};
+    uint64_t jumps_taken = 0;
+    uint64_t jumps_not_taken = 0;
 };
 
 // Instruction registry
+//
+// Dispatch is one load and one indirect call: every opcode byte indexes a flat
+// table of plain function pointers. Registration fills the table, freeze()
+// seals it, and unregistered opcodes land on a trap handler. Mnemonics and
+// types live in a separate table that execute() never touches.
+//
+// Handlers report control flow through ExecStatus; exceptions are left for
+// host errors such as allocation failure.
 class InstructionSet {
 public:
-    void register_instruction(uint8_t opcode, const std::string& mnemonic, OpcodeType type, const std::function<void(ExecutionContext&)>& exec_func);
-    void execute(uint8_t opcode, ExecutionContext& context);
-    std::string get_mnemonic(uint8_t opcode) const;
+    using Handler = ExecStatus (*)(ExecutionContext&);
+
+    InstructionSet() {
+        handlers.fill(&trap);
+    }
+
+    // Captureless lambdas convert to Handler. Throws once the set is frozen.
+    void register_instruction(uint8_t opcode, const std::string& mnemonic, OpcodeType type, Handler exec_func) {
+        if (sealed) {
+            throw std::logic_error("InstructionSet is frozen; cannot register " + mnemonic);
+        }
+        if (!exec_func) {
+            throw std::invalid_argument("Null handler for " + mnemonic);
+        }
+        handlers[opcode] = exec_func;
+        info[opcode] = OpInfo{ mnemonic, type, true };
+    }
+
+    // Seals the table; call once all instructions are registered.
+    void freeze() {
+        sealed = true;
+    }
+
+    bool frozen() const {
+        return sealed;
+    }
+
+    bool is_registered(uint8_t opcode) const {
+        return info[opcode].registered;
+    }
+
+    ExecStatus execute(uint8_t opcode, ExecutionContext& context) const {
+#if EXECUE_PROFILE
+        if (profiler) {
+            const uint64_t start = OpcodeProfiler::now();
+            const ExecStatus status = handlers[opcode](context);
+            profiler->record(opcode, info[opcode].type, OpcodeProfiler::now() - start, status);
+            return status;
+        }
+#endif
+        return handlers[opcode](context);
+    }
+
+#if EXECUE_PROFILE
+    // Starts recording into `target`; nullptr stops. Not owned.
+    void attach_profiler(OpcodeProfiler* target) {
+        profiler = target;
+    }
+#endif
+
+    // Fetch-dispatch loop from the current program counter. Returns the HALT
+    // or FAULT status that stopped it, or a STEP_LIMIT fault after max_steps.
+    ExecStatus run(ExecutionContext& context, uint64_t max_steps = UINT64_MAX) const {
+        for (uint64_t step = 0; step < max_steps; ++step) {
+            if (context.program_counter >= context.memory.size()) {
+                log_stop(context, ExecStatus::failed(FaultCode::PC_OUT_OF_RANGE));
+                return ExecStatus::failed(FaultCode::PC_OUT_OF_RANGE);
+            }
+            const ExecStatus status = execute(context.memory[context.program_counter], context);
+            if (!status.running()) {
+                log_stop(context, status);
+                return status;
+            }
+        }
+        return ExecStatus::failed(FaultCode::STEP_LIMIT);
+    }
+
+    std::string get_mnemonic(uint8_t opcode) const {
+        return info[opcode].registered ? info[opcode].mnemonic : "???";
+    }
+
+    OpcodeType get_type(uint8_t opcode) const {
+        if (!info[opcode].registered) {
+            throw std::out_of_range("Unregistered opcode");
+        }
+        return info[opcode].type;
+    }
 
 private:
-    struct RegisteredOp {
+    struct OpInfo {
         std::string mnemonic;
-        OpcodeType type;
-        std::function<void(ExecutionContext&)> exec;
+        OpcodeType type = OpcodeType::CONTROL;
+        bool registered = false;
     };
 
-    std::unordered_map<uint8_t, RegisteredOp> instructions;
+    // Shared by every unregistered slot; the program counter still points at
+    // the offending opcode.
+    static ExecStatus trap(ExecutionContext&) {
+        return ExecStatus::failed(FaultCode::ILLEGAL_OPCODE);
+    }
+
+    std::array<Handler, 256> handlers;
+    std::array<OpInfo, 256> info;
+    bool sealed = false;
+#if EXECUE_PROFILE
+    OpcodeProfiler* profiler = nullptr;
+#endif
 };
 
-// Macros to define instructions
-#define DEFINE_INSTRUCTION(set, code, name, type, func) \
-    set.register_instruction(code, name, type, func)
+inline std::string OpcodeProfiler::to_json(const InstructionSet& set) const {
+    const auto quoted = [](const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out + "\"";
+    };
+    const auto fields = [](const Counter& counter) {
+        return "\"count\":" + std::to_string(counter.count) + ",\"cost\":" + std::to_string(counter.cost);
+    };
 
-// Sample Instructions
-inline void define_core_instructions(InstructionSet& set) {
-    DEFINE_INSTRUCTION(set, 0x01, "LOAD", OpcodeType::READ, [](ExecutionContext& ctx) {
-        ctx.registers["A"] = ctx.memory[ctx.program_counter + 1];
+    std::string out = "{\"unit\":\"" + std::string(unit()) + "\",\"total\":{" + fields(total()) + "},\"opcodes\":[";
+    bool first = true;
+    for (size_t code = 0; code < opcodes.size(); ++code) {
+        if (opcodes[code].count == 0) continue;
+        if (!first) out += ',';
+        first = false;
+        out += "{\"opcode\":" + std::to_string(code) + ",\"mnemonic\":" +
+               quoted(set.get_mnemonic(static_cast<uint8_t>(code))) + "," + fields(opcodes[code]) + "}";
+    }
+    out += "],\"categories\":[";
+    first = true;
+    for (size_t type = 0; type < categories.size(); ++type) {
+        if (categories[type].count == 0) continue;
+        if (!first) out += ',';
+        first = false;
+        out += "{\"type\":\"" + std::string(opcode_type_name(static_cast<OpcodeType>(type))) + "\"," +
+               fields(categories[type]) + "}";
+    }
+    out += "],\"jumps\":{\"taken\":" + std::to_string(jumps_taken) +
+           ",\"not_taken\":" + std::to_string(jumps_not_taken) + "}}";
+    return out;
+}
+
+inline std::string OpcodeProfiler::to_table(const InstructionSet& set) const {
+    std::string out;
+    char row[128];
+    const auto line = [&](const char* code, const std::string& name, const Counter& counter) {
+        const double average = counter.count ? static_cast<double>(counter.cost) / counter.count : 0.0;
+        std::snprintf(row, sizeof(row), "%-6s %-12s %14llu %16llu %10.1f\n", code, name.c_str(),
+                      static_cast<unsigned long long>(counter.count),
+                      static_cast<unsigned long long>(counter.cost), average);
+        out += row;
+    };
+
+    std::snprintf(row, sizeof(row), "%-6s %-12s %14s %16s %10s\n", "opcode", "mnemonic", "count", unit(), "avg");
+    out += row;
+    for (size_t code = 0; code < opcodes.size(); ++code) {
+        if (opcodes[code].count == 0) continue;
+        char hex[8];
+        std::snprintf(hex, sizeof(hex), "0x%02x", static_cast<unsigned>(static_cast<uint8_t>(code)));
+        line(hex, set.get_mnemonic(static_cast<uint8_t>(code)), opcodes[code]);
+    }
+    for (size_t type = 0; type < categories.size(); ++type) {
+        if (categories[type].count == 0) continue;
+        line("type", opcode_type_name(static_cast<OpcodeType>(type)), categories[type]);
+    }
+    line("total", "", total());
+    out += "jumps taken: " + std::to_string(jumps_taken) + ", not taken: " + std::to_string(jumps_not_taken) + "\n";
+    return out;
+}
+
+// Compile-time instruction declarations
+//
+// Each instruction is a type carrying its opcode byte, mnemonic, category,
+// encoded length (opcode plus operand bytes), whether execution can fall
+// through to the next instruction, and two handlers:
+//
+//     struct LoadOp {
+//         static constexpr uint8_t code = 0x01;
+//         static constexpr const char* mnemonic = "LOAD";
+//         static constexpr OpcodeType type = OpcodeType::READ;
+//         static constexpr uint8_t length = 2;
+//         static constexpr bool falls_through = true;
+//         static ExecStatus exec(ExecutionContext& ctx);            // checked
+//         static ExecStatus exec_unchecked(ExecutionContext& ctx);  // verified images only
+//     };
+//
+// For JUMP-type instructions the first operand byte is the absolute target.
+// InstructionTable<Ops...> turns a list of these into a statically dispatched
+// interpreter loop plus constexpr mnemonic and disassembly tables.
+
+struct LoadOp {
+    static constexpr uint8_t code = 0x01;
+    static constexpr const char* mnemonic = "LOAD";
+    static constexpr OpcodeType type = OpcodeType::READ;
+    static constexpr uint8_t length = 2;
+    static constexpr bool falls_through = true;
+
+    static ExecStatus exec_unchecked(ExecutionContext& ctx) {
+        ctx.registers[REG_A] = ctx.memory[ctx.program_counter + 1];
         ctx.program_counter += 2;
-    });
+        return ExecStatus::next();
+    }
+
+    static ExecStatus exec(ExecutionContext& ctx) {
+        if (ctx.program_counter + 1 >= ctx.memory.size()) {
+            return ExecStatus::failed(FaultCode::MEMORY_OUT_OF_RANGE);
+        }
+        return exec_unchecked(ctx);
+    }
+};
+
+// Writes A into its own operand byte, so it never changes what a verified
+// image decodes to.
+struct StoreOp {
+    static constexpr uint8_t code = 0x02;
+    static constexpr const char* mnemonic = "STORE";
+    static constexpr OpcodeType type = OpcodeType::WRITE;
+    static constexpr uint8_t length = 2;
+    static constexpr bool falls_through = true;
 
-    DEFINE_INSTRUCTION(set, 0x02, "STORE", OpcodeType::WRITE, [](ExecutionContext& ctx) {
-        ctx.memory[ctx.program_counter + 1] = static_cast<uint8_t>(ctx.registers["A"]);
+    static ExecStatus exec_unchecked(ExecutionContext& ctx) {
+        ctx.memory[ctx.program_counter + 1] = static_cast<uint8_t>(ctx.registers[REG_A]);
         ctx.program_counter += 2;
-    });
+        return ExecStatus::next();
+    }
+
+    static ExecStatus exec(ExecutionContext& ctx) {
+        if (ctx.program_counter + 1 >= ctx.memory.size()) {
+            return ExecStatus::failed(FaultCode::MEMORY_OUT_OF_RANGE);
+        }
+        return exec_unchecked(ctx);
+    }
+};
 
-    DEFINE_INSTRUCTION(set, 0x10, "JMP", OpcodeType::JUMP, [](ExecutionContext& ctx) {
+struct JmpOp {
+    static constexpr uint8_t code = 0x10;
+    static constexpr const char* mnemonic = "JMP";
+    static constexpr OpcodeType type = OpcodeType::JUMP;
+    static constexpr uint8_t length = 2;
+    static constexpr bool falls_through = false;
+
+    static ExecStatus exec_unchecked(ExecutionContext& ctx) {
         ctx.program_counter = ctx.memory[ctx.program_counter + 1];
-    });
+        return ExecStatus::jump();
+    }
+
+    static ExecStatus exec(ExecutionContext& ctx) {
+        if (ctx.program_counter + 1 >= ctx.memory.size()) {
+            return ExecStatus::failed(FaultCode::MEMORY_OUT_OF_RANGE);
+        }
+        return exec_unchecked(ctx);
+    }
+};
+
+struct HaltOp {
+    static constexpr uint8_t code = 0xFF;
+    static constexpr const char* mnemonic = "HALT";
+    static constexpr OpcodeType type = OpcodeType::CONTROL;
+    static constexpr uint8_t length = 1;
+    static constexpr bool falls_through = false;
+
+    static ExecStatus exec_unchecked(ExecutionContext&) {
+        return ExecStatus::halt();
+    }
+
+    static ExecStatus exec(ExecutionContext& ctx) {
+        return exec_unchecked(ctx);
+    }
+};
+
+// Outcome of InstructionTable::verify. On failure `offset` is the byte the
+// verifier rejected.
+struct VerifyResult {
+    bool ok = true;
+    uint32_t offset = 0;
+    std::string reason;
+};
+
+template <typename... Ops>
+class InstructionTable {
+public:
+    struct Entry {
+        const char* mnemonic;
+        OpcodeType type;
+        uint8_t length;  // 0 for unassigned opcodes
+        bool falls_through;
+    };
+
+private:
+    static constexpr bool codes_unique() {
+        const uint8_t codes[] = { Ops::code... };
+        for (size_t i = 0; i < sizeof...(Ops); ++i) {
+            for (size_t j = i + 1; j < sizeof...(Ops); ++j) {
+                if (codes[i] == codes[j]) return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(sizeof...(Ops) > 0, "InstructionTable needs at least one instruction");
+    static_assert(codes_unique(), "InstructionTable has two instructions with the same opcode");
+    static_assert(((Ops::length >= 1) && ...), "Instruction length includes the opcode byte");
+
+    static constexpr std::array<Entry, 256> build() {
+        std::array<Entry, 256> table{};
+        for (auto& entry : table) {
+            entry = Entry{ "???", OpcodeType::CONTROL, 0, false };
+        }
+        ((table[Ops::code] = Entry{ Ops::mnemonic, Ops::type, Ops::length, Ops::falls_through }), ...);
+        return table;
+    }
 
-    DEFINE_INSTRUCTION(set, 0xFF, "HALT", OpcodeType::CONTROL, [](ExecutionContext& ctx) {
-        throw std::runtime_error("Execution Halted");
-    });
+public:
+    static constexpr size_t size = sizeof...(Ops);
+    static constexpr std::array<Entry, 256> entries = build();
+
+    static constexpr bool defined(uint8_t opcode) {
+        return entries[opcode].length != 0;
+    }
+
+    static constexpr const char* mnemonic(uint8_t opcode) {
+        return entries[opcode].mnemonic;
+    }
+
+    // Static dispatch: the fold expands to a chain of constant comparisons the
+    // compiler lowers to a jump table and inlines each handler into.
+    static ExecStatus execute(uint8_t opcode, ExecutionContext& ctx) {
+        ExecStatus status = ExecStatus::failed(FaultCode::ILLEGAL_OPCODE);
+        (void)((opcode == Ops::code && (status = Ops::exec(ctx), true)) || ...);
+        return status;
+    }
+
+    // Fast path for verified images: no fetch or operand bounds checks.
+    static ExecStatus execute_unchecked(uint8_t opcode, ExecutionContext& ctx) {
+        ExecStatus status = ExecStatus::failed(FaultCode::ILLEGAL_OPCODE);
+        (void)((opcode == Ops::code && (status = Ops::exec_unchecked(ctx), true)) || ...);
+        return status;
+    }
+
+    // Walks every instruction reachable from the entry point, following
+    // fall-through and jump targets, and checks that each opcode is defined,
+    // its operands lie inside the image, nothing falls off the end, and no
+    // jump lands inside another instruction. Bytes that are never reached
+    // (data, padding) are not inspected. Sets ctx.verified on success.
+    static VerifyResult verify(ExecutionContext& ctx) {
+        enum : uint8_t { UNSEEN, START, OPERAND };
+        const std::vector<uint8_t>& memory = ctx.memory;
+        std::vector<uint8_t> marks(memory.size(), UNSEEN);
+        std::vector<uint32_t> pending{ ctx.program_counter };
+        const auto reject = [&](uint32_t offset, const char* reason) {
+            ctx.verified = false;
+            return VerifyResult{ false, offset, reason };
+        };
+
+        while (!pending.empty()) {
+            const uint32_t pc = pending.back();
+            pending.pop_back();
+            if (pc >= memory.size()) return reject(pc, "jump target outside the image");
+            if (marks[pc] == START) continue;
+            if (marks[pc] == OPERAND) return reject(pc, "jump into the middle of an instruction");
+
+            const Entry& entry = entries[memory[pc]];
+            if (entry.length == 0) return reject(pc, "undefined opcode");
+            if (pc + entry.length > memory.size()) return reject(pc, "operand past the end of the image");
+            marks[pc] = START;
+            for (uint32_t i = 1; i < entry.length; ++i) {
+                if (marks[pc + i] == START) return reject(pc + i, "instructions overlap");
+                marks[pc + i] = OPERAND;
+            }
+            if (entry.falls_through) {
+                if (pc + entry.length >= memory.size()) return reject(pc, "execution falls off the end of the image");
+                pending.push_back(pc + entry.length);
+            }
+            if (entry.type == OpcodeType::JUMP && entry.length > 1) {
+                pending.push_back(memory[pc + 1]);
+            }
+        }
+        ctx.verified = true;
+        return VerifyResult{};
+    }
+
+    // Same contract as InstructionSet::run. Verified images take the
+    // unchecked fast path; anything else runs fully checked.
+    static ExecStatus run(ExecutionContext& ctx, uint64_t max_steps = UINT64_MAX) {
+        if (ctx.verified) {
+            for (uint64_t step = 0; step < max_steps; ++step) {
+                const ExecStatus status = execute_unchecked(ctx.memory[ctx.program_counter], ctx);
+                if (!status.running()) {
+                    log_stop(ctx, status);
+                    return status;
+                }
+            }
+            return ExecStatus::failed(FaultCode::STEP_LIMIT);
+        }
+        for (uint64_t step = 0; step < max_steps; ++step) {
+            if (ctx.program_counter >= ctx.memory.size()) {
+                log_stop(ctx, ExecStatus::failed(FaultCode::PC_OUT_OF_RANGE));
+                return ExecStatus::failed(FaultCode::PC_OUT_OF_RANGE);
+            }
+            const ExecStatus status = execute(ctx.memory[ctx.program_counter], ctx);
+            if (!status.running()) {
+                log_stop(ctx, status);
+                return status;
+            }
+        }
+        return ExecStatus::failed(FaultCode::STEP_LIMIT);
+    }
+
+    // One line per instruction: "0004: LOAD 5". Unassigned bytes print as
+    // ".byte N"; a truncated final instruction prints what is present.
+    static std::string disassemble(const std::vector<uint8_t>& memory) {
+        std::string out;
+        size_t pc = 0;
+        while (pc < memory.size()) {
+            const Entry& entry = entries[memory[pc]];
+            char address[24];
+            std::snprintf(address, sizeof(address), "%04zx: ", pc);
+            out += address;
+            if (entry.length == 0) {
+                out += ".byte " + std::to_string(memory[pc]) + "\n";
+                ++pc;
+                continue;
+            }
+            out += entry.mnemonic;
+            for (size_t i = 1; i < entry.length && pc + i < memory.size(); ++i) {
+                out += ' ';
+                out += std::to_string(memory[pc + i]);
+            }
+            out += '\n';
+            pc += entry.length;
+        }
+        return out;
+    }
+
+    // Copies the declarations into a runtime registry, for hosts that extend
+    // the set with instructions only known at run time.
+    static void register_into(InstructionSet& set) {
+        (set.register_instruction(Ops::code, Ops::mnemonic, Ops::type, &Ops::exec), ...);
+    }
+};
+
+using CoreInstructions = InstructionTable<LoadOp, StoreOp, JmpOp, HaltOp>;
+
+// Sample Instructions
+inline void define_core_instructions(InstructionSet& set) {
+    CoreInstructions::register_into(set);
 }
 
 } // namespace execue
@@ -6,10 +6,21 @@
 #include <mutex>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <unordered_map>
+#include <stdexcept>
+#include <exception>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "src/runtime/cancellation.h"
 
 // Global runtime settings and flags
-#define MAX_RUNTIME_THREADS 4          // Max concurrent threads during execution
-#define EXECUTION_TIMEOUT 30000       // Timeout for execution in milliseconds (for long-running tasks)
+#define MAX_RUNTIME_THREADS 4          // Worker threads in the task pool
+#define EXECUTION_TIMEOUT 30000       // Default Task::timeout in milliseconds (for long-running tasks)
 
 // Enum for Runtime States
 enum class RuntimeState {
@@ -17,57 +28,430 @@ enum class RuntimeState {
     RUNNING,
     PAUSED,
     COMPLETED,
-    ERROR
+    ERROR,
+    CANCELLED   // cancelled or overdue, or a task it depends on did not complete
 };
 
-// Struct to represent a process or task in runtime
+// What wait() throws for a CANCELLED task.
+class TaskCancelled : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+// Struct to represent a process or task in runtime. It is also the handle
+// TaskManager hands back: the worker running it updates `state`, and wait()
+// blocks until it has finished.
+//
+// A task runs only after every task in `dependencies` has COMPLETED; if one
+// of them fails or is cancelled, the task is CANCELLED without running, and
+// so is everything downstream of it. Dependencies are fixed once the task is
+// started.
+//
+// Cancellation is cooperative: cancel(), or the deadline scheduler once the
+// task has run for `timeout`, trips the task's token, and `work` is expected
+// to poll it (capture token() by value, not the task). A task cancelled
+// before it runs never runs; one cancelled while running ends CANCELLED
+// however its work returns; a cancel after its work has returned is ignored.
 struct Task {
     std::string taskName;
-    bool isComplete;
-    RuntimeState state;
+    std::function<void()> work;
+    std::vector<std::shared_ptr<Task>> dependencies;
+    std::chrono::milliseconds timeout{ EXECUTION_TIMEOUT };  // Zero: no deadline
+    std::atomic<bool> isComplete;
+    std::atomic<RuntimeState> state;
+
+    Task(std::string name, std::function<void()> work = nullptr)
+        : taskName(std::move(name)), work(std::move(work)), isComplete(false), state(RuntimeState::IDLE) {}
+
+    void dependsOn(std::shared_ptr<Task> task) {
+        if (!task) throw std::invalid_argument("Task " + taskName + " cannot depend on a null task");
+        dependencies.push_back(std::move(task));
+    }
+
+    bool isStarted() const {
+        return started.load();
+    }
+
+    execue::CancellationToken token() const {
+        return cancellation.token();
+    }
 
-    Task(std::string name) : taskName(name), isComplete(false), state(RuntimeState::IDLE) {}
+    void cancel() {
+        cancellation.cancel();
+    }
+
+    // Rethrows whatever `work` threw (state is then ERROR), or TaskCancelled.
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        done.wait(guard, [&] { return isComplete.load(); });
+        if (failure) std::rethrow_exception(failure);
+    }
+
+private:
+    friend class TaskManager;
+
+    std::mutex lock;
+    std::condition_variable done;
+    std::exception_ptr failure;
+    execue::CancellationSource cancellation;
+    std::vector<std::shared_ptr<Task>> dependents;  // Guarded by lock; emptied on finish
+    std::atomic<size_t> blockers{ 0 };              // Dependencies not yet COMPLETED
+    std::atomic<bool> settled{ false };             // Queued or cancelled: decided once
+    std::atomic<bool> started{ false };
+};
+
+// How the tasks a TaskManager has finished ended. `cancelled` counts every
+// CANCELLED task, the `timedOut` ones included.
+struct TaskCounters {
+    size_t completed = 0;
+    size_t failed = 0;
+    size_t cancelled = 0;
+    size_t timedOut = 0;
 };
 
-// Task Execution Manager
+// Task Execution Manager: a fixed pool of workers, each with its own deque.
+// A worker runs its own deque from the front and, once that is empty, steals
+// from the back of the others. Tasks started from inside a task go to the
+// current worker's deque; the rest are dealt round-robin. Nothing is refused:
+// tasks beyond the worker count wait in the deques until a worker is free.
+//
+// Each worker publishes the task it is running and that task's deadline; one
+// deadline scheduler thread sleeps until the earliest of them and cancels
+// overdue tasks with CancelReason::DEADLINE.
 class TaskManager {
 public:
-    TaskManager(int maxThreads) : maxThreads(maxThreads), activeThreads(0) {
-        threads.reserve(maxThreads);
+    explicit TaskManager(int maxThreads) {
+        const size_t count = static_cast<size_t>(std::max(1, maxThreads));
+        for (size_t i = 0; i < count; ++i) lanes.push_back(std::make_unique<Lane>());
+        workers.reserve(count);
+        for (size_t i = 0; i < count; ++i) workers.emplace_back(&TaskManager::workerLoop, this, i);
+        scheduler = std::thread(&TaskManager::watchDeadlines, this);
+    }
+
+    TaskManager(const TaskManager&) = delete;
+    TaskManager& operator=(const TaskManager&) = delete;
+
+    // Runs whatever is still queued, then stops the workers.
+    ~TaskManager() {
+        {
+            std::lock_guard<std::mutex> guard(control);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) worker.join();
+        {
+            std::lock_guard<std::mutex> guard(deadlineLock);
+            closing = true;
+        }
+        deadlineWake.notify_one();
+        scheduler.join();
     }
 
+    // Queues the task once all its dependencies have completed; until then it
+    // stays IDLE. Those dependencies must be started too (see
+    // Runtime::executeTasks) or the task never runs. A task starts once.
     void startTask(std::shared_ptr<Task> task) {
-        if (activeThreads < maxThreads) {
-            task->state = RuntimeState::RUNNING;
-            threads.push_back(std::thread(&TaskManager::runTask, this, task));
-            activeThreads++;
-        } else {
-            std::cerr << "Max thread limit reached. Cannot start more tasks." << std::endl;
+        if (task->started.exchange(true)) {
+            throw std::logic_error("Task " + task->taskName + " was already started");
+        }
+        task->state = RuntimeState::IDLE;
+        unfinished.fetch_add(1);
+        // One blocker per dependency, plus one held while registering so the
+        // task cannot be released before every dependency has been seen.
+        task->blockers = task->dependencies.size() + 1;
+        for (const auto& dependency : task->dependencies) {
+            std::unique_lock<std::mutex> guard(dependency->lock);
+            if (!dependency->isComplete) {
+                dependency->dependents.push_back(task);
+                continue;
+            }
+            guard.unlock();
+            resolve(task, *dependency);
         }
+        release(task);
     }
 
-    void runTask(std::shared_ptr<Task> task) {
-        std::cout << "Starting task: " << task->taskName << std::endl;
-        // Simulate task execution by sleeping
-        std::this_thread::sleep_for(std::chrono::milliseconds(5000)); // Simulate task execution time
-        task->isComplete = true;
-        task->state = RuntimeState::COMPLETED;
-        activeThreads--;
-        std::cout << "Task " << task->taskName << " completed." << std::endl;
+    std::shared_ptr<Task> submit(std::string name, std::function<void()> work) {
+        auto task = std::make_shared<Task>(std::move(name), std::move(work));
+        startTask(task);
+        return task;
     }
 
+    // Blocks until every task started so far has finished or been cancelled;
+    // the workers stay up.
     void waitForTasks() {
-        for (auto& thread : threads) {
-            if (thread.joinable()) {
-                thread.join();
+        std::unique_lock<std::mutex> guard(control);
+        idle.wait(guard, [&] { return unfinished.load() == 0; });
+    }
+
+    size_t workerCount() const {
+        return workers.size();
+    }
+
+    TaskCounters counters() const {
+        TaskCounters counts;
+        counts.completed = completedTasks.load();
+        counts.failed = failedTasks.load();
+        counts.cancelled = cancelledTasks.load();
+        counts.timedOut = timedOutTasks.load();
+        return counts;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // The scheduler rescans at least this often, so only tasks with shorter
+    // timeouts need to wake it when they start.
+    static constexpr std::chrono::milliseconds kDeadlineRescan{ 100 };
+
+    struct alignas(64) Lane {
+        std::mutex lock;
+        std::deque<std::shared_ptr<Task>> pending;
+        std::mutex watchLock;        // Guards running/deadline
+        Task* running = nullptr;     // Watched task on this lane's worker
+        Clock::time_point deadline;
+    };
+
+    void enqueue(std::shared_ptr<Task> task) {
+        // Counted before it is visible, so a worker never sees more tasks
+        // than `queued` admits.
+        queued.fetch_add(1);
+        const size_t lane = currentManager == this ? currentLane : nextLane.fetch_add(1, std::memory_order_relaxed) % lanes.size();
+        {
+            std::lock_guard<std::mutex> guard(lanes[lane]->lock);
+            lanes[lane]->pending.push_back(std::move(task));
+        }
+        if (sleepers.load() > 0) {
+            std::lock_guard<std::mutex> guard(control);
+            wake.notify_one();
+        }
+    }
+
+    bool take(size_t self, std::shared_ptr<Task>& task) {
+        for (size_t step = 0; step < lanes.size(); ++step) {
+            Lane& lane = *lanes[(self + step) % lanes.size()];
+            std::lock_guard<std::mutex> guard(lane.lock);
+            if (lane.pending.empty()) continue;
+            if (step == 0) {
+                task = std::move(lane.pending.front());
+                lane.pending.pop_front();
+            } else {
+                task = std::move(lane.pending.back());
+                lane.pending.pop_back();
             }
+            queued.fetch_sub(1);
+            return true;
         }
+        return false;
     }
 
-private:
-    int maxThreads;                         // Max concurrent threads
-    std::atomic<int> activeThreads;         // Count of active threads
-    std::vector<std::thread> threads;       // List of threads
+    // `dependency` has finished: release the task after its last completed
+    // dependency, or cancel it on the first one that did not complete.
+    void resolve(const std::shared_ptr<Task>& task, const Task& dependency) {
+        if (dependency.state == RuntimeState::COMPLETED) {
+            release(task);
+        } else if (!task->settled.exchange(true)) {
+            finish(task, RuntimeState::CANCELLED, cancellation(*task, dependency));
+        }
+    }
+
+    void release(const std::shared_ptr<Task>& task) {
+        if (task->blockers.fetch_sub(1) == 1 && !task->settled.exchange(true)) {
+            enqueue(task);
+        }
+    }
+
+    static std::exception_ptr cancellation(const Task& task, const Task& dependency) {
+        return std::make_exception_ptr(TaskCancelled(
+            "Task " + task.taskName + " cancelled: dependency " + dependency.taskName + " did not complete"));
+    }
+
+    static std::exception_ptr cancellation(const Task& task) {
+        if (task.cancellation.reason() == execue::CancelReason::DEADLINE) {
+            return std::make_exception_ptr(TaskCancelled(
+                "Task " + task.taskName + " exceeded its " + std::to_string(task.timeout.count()) + " ms deadline"));
+        }
+        return std::make_exception_ptr(TaskCancelled("Task " + task.taskName + " cancelled"));
+    }
+
+    void runTask(size_t self, const std::shared_ptr<Task>& task) {
+        if (task->cancellation.cancelled()) {
+            finish(task, RuntimeState::CANCELLED, cancellation(*task));
+            return;
+        }
+        task->state = RuntimeState::RUNNING;
+        const bool watched = task->timeout.count() > 0;
+        if (watched) watch(*lanes[self], task.get());
+        std::exception_ptr error;
+        try {
+            if (task->work) task->work();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        // Decided as soon as work returns: the deadline scheduler can still trip
+        // the token until `running` is cleared, and the owner at any time, but
+        // such a late cancel does not undo finished work.
+        const bool cancelled = task->cancellation.cancelled();
+        if (watched) {
+            std::lock_guard<std::mutex> guard(lanes[self]->watchLock);
+            lanes[self]->running = nullptr;
+        }
+        if (cancelled) {
+            finish(task, RuntimeState::CANCELLED, cancellation(*task));
+        } else {
+            finish(task, error ? RuntimeState::ERROR : RuntimeState::COMPLETED, error);
+        }
+    }
+
+    void watch(Lane& lane, Task* task) {
+        const auto deadline = Clock::now() + task->timeout;
+        {
+            std::lock_guard<std::mutex> guard(lane.watchLock);
+            lane.running = task;
+            lane.deadline = deadline;
+        }
+        // The scheduler publishes when it will next look; only a deadline
+        // before that has to wake it.
+        if (deadline < nextDeadline.load()) {
+            std::lock_guard<std::mutex> guard(deadlineLock);
+            rescan = true;
+            deadlineWake.notify_one();
+        }
+    }
+
+    // Deadline scheduler. nextDeadline is raised to the far future for the
+    // length of each scan, so a worker that starts a task the scan missed
+    // always wakes the scheduler, and one that starts after the scan compares
+    // against its result.
+    void watchDeadlines() {
+        std::unique_lock<std::mutex> guard(deadlineLock);
+        for (;;) {
+            rescan = false;
+            nextDeadline = Clock::time_point::max();
+            guard.unlock();
+            const auto now = Clock::now();
+            auto next = now + kDeadlineRescan;
+            for (const auto& lane : lanes) {
+                std::lock_guard<std::mutex> watched(lane->watchLock);
+                if (!lane->running) continue;
+                if (lane->deadline > now) {
+                    next = std::min(next, lane->deadline);
+                } else {
+                    lane->running->cancellation.cancel(execue::CancelReason::DEADLINE);
+                }
+            }
+            nextDeadline = next;
+            guard.lock();
+            deadlineWake.wait_until(guard, next, [&] { return closing || rescan; });
+            if (closing) return;
+        }
+    }
+
+    // Publishes the outcome, then resolves the dependents: after a completed
+    // task they may be queued (on this worker's deque); after a failed or
+    // cancelled one they are cancelled too. Cancellation walks the graph with
+    // a worklist, so deep chains do not deepen the stack.
+    void finish(const std::shared_ptr<Task>& task, RuntimeState outcome, std::exception_ptr error) {
+        struct Outcome {
+            std::shared_ptr<Task> task;
+            RuntimeState state;
+            std::exception_ptr error;
+        };
+        std::vector<Outcome> pending{ Outcome{ task, outcome, std::move(error) } };
+        std::vector<std::shared_ptr<Task>> downstream;
+        while (!pending.empty()) {
+            const Outcome next = std::move(pending.back());
+            pending.pop_back();
+            {
+                std::lock_guard<std::mutex> guard(next.task->lock);
+                next.task->failure = next.error;
+                next.task->state = next.state;
+                next.task->isComplete = true;
+                downstream.swap(next.task->dependents);
+            }
+            next.task->done.notify_all();
+            count(*next.task, next.state);
+            for (const auto& dependent : downstream) {
+                if (next.state == RuntimeState::COMPLETED) {
+                    release(dependent);
+                } else if (!dependent->settled.exchange(true)) {
+                    pending.push_back(Outcome{ dependent, RuntimeState::CANCELLED, cancellation(*dependent, *next.task) });
+                }
+            }
+            downstream.clear();
+            if (unfinished.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> guard(control);
+                idle.notify_all();
+            }
+        }
+    }
+
+    void count(const Task& task, RuntimeState outcome) {
+        switch (outcome) {
+            case RuntimeState::COMPLETED: completedTasks.fetch_add(1, std::memory_order_relaxed); break;
+            case RuntimeState::ERROR: failedTasks.fetch_add(1, std::memory_order_relaxed); break;
+            case RuntimeState::CANCELLED:
+                cancelledTasks.fetch_add(1, std::memory_order_relaxed);
+                if (task.cancellation.reason() == execue::CancelReason::DEADLINE) {
+                    timedOutTasks.fetch_add(1, std::memory_order_relaxed);
+                }
+                break;
+            default: break;
+        }
+    }
+
+    void workerLoop(size_t self) {
+        currentManager = this;
+        currentLane = self;
+        std::shared_ptr<Task> task;
+        for (;;) {
+            // Tiny tasks arrive faster than a sleeping worker can be woken,
+            // so look around a few more times before going to sleep.
+            bool found = false;
+            for (int attempt = 0; attempt < 64 && !found; ++attempt) {
+                found = take(self, task);
+                if (!found) std::this_thread::yield();
+            }
+            if (found) {
+                runTask(self, task);
+                task.reset();
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(control);
+            // Paired with the sleepers check in startTask: either the
+            // submitter sees this worker asleep or the worker sees the task.
+            sleepers.fetch_add(1);
+            wake.wait(guard, [&] { return stopping || queued.load() > 0; });
+            sleepers.fetch_sub(1);
+            if (stopping && queued.load() == 0) return;
+        }
+    }
+
+    inline static thread_local TaskManager* currentManager = nullptr;
+    inline static thread_local size_t currentLane = 0;
+
+    std::vector<std::unique_ptr<Lane>> lanes;
+    std::vector<std::thread> workers;       // Persistent worker threads
+    std::mutex control;
+    std::condition_variable wake;           // Work arrived, or stopping
+    std::condition_variable idle;           // unfinished reached zero
+    std::atomic<size_t> queued{ 0 };        // Tasks sitting in the deques
+    std::atomic<size_t> unfinished{ 0 };    // Started and not yet finished
+    std::atomic<size_t> sleepers{ 0 };
+    std::atomic<size_t> nextLane{ 0 };
+    bool stopping = false;
+
+    std::thread scheduler;                  // Deadline scheduler
+    std::mutex deadlineLock;
+    std::condition_variable deadlineWake;   // A shorter deadline started, or closing
+    std::atomic<Clock::time_point> nextDeadline{ Clock::time_point::max() };
+    bool rescan = false;
+    bool closing = false;
+
+    std::atomic<size_t> completedTasks{ 0 };
+    std::atomic<size_t> failedTasks{ 0 };
+    std::atomic<size_t> cancelledTasks{ 0 };
+    std::atomic<size_t> timedOutTasks{ 0 };
 };
 
 // Resource Manager to manage dynamic resources like memory, file I/O, etc.
@@ -131,10 +515,20 @@ public:
     }
 
     void executeTask(std::shared_ptr<Task> task) {
-        if (currentState == RuntimeState::RUNNING) {
-            taskManager->startTask(task);
-        } else {
+        executeTasks({ std::move(task) });
+    }
+
+    // Starts the tasks and every not-yet-started task they depend on,
+    // upstream first. Independent branches run in parallel as soon as their
+    // own dependencies complete. Throws std::invalid_argument, before starting
+    // anything, if the dependencies form a cycle.
+    void executeTasks(const std::vector<std::shared_ptr<Task>>& tasks) {
+        if (currentState != RuntimeState::RUNNING) {
             std::cerr << "Runtime is not in a running state." << std::endl;
+            return;
+        }
+        for (const auto& task : dependencyOrder(tasks)) {
+            taskManager->startTask(task);
         }
     }
 
@@ -163,15 +557,232 @@ public:
         return currentState;
     }
 
+    TaskCounters taskCounters() const {
+        return taskManager->counters();
+    }
+
 private:
+    // Depth-first post-order over the unstarted part of the graph, iterative
+    // so long chains are fine.
+    static std::vector<std::shared_ptr<Task>> dependencyOrder(const std::vector<std::shared_ptr<Task>>& roots) {
+        enum Mark { UNSEEN, OPEN, DONE };
+        struct Frame {
+            std::shared_ptr<Task> task;
+            size_t next;
+        };
+        std::unordered_map<const Task*, Mark> marks;
+        std::vector<std::shared_ptr<Task>> order;
+        std::vector<Frame> path;
+        for (const auto& root : roots) {
+            if (root->isStarted() || marks[root.get()] == DONE) continue;
+            marks[root.get()] = OPEN;
+            path.push_back(Frame{ root, 0 });
+            while (!path.empty()) {
+                Frame& frame = path.back();
+                if (frame.next == frame.task->dependencies.size()) {
+                    marks[frame.task.get()] = DONE;
+                    order.push_back(std::move(frame.task));
+                    path.pop_back();
+                    continue;
+                }
+                std::shared_ptr<Task> dependency = frame.task->dependencies[frame.next++];
+                if (dependency->isStarted()) continue;
+                Mark& mark = marks[dependency.get()];
+                if (mark == OPEN) {
+                    throw std::invalid_argument("Dependency cycle through task " + dependency->taskName);
+                }
+                if (mark == UNSEEN) {
+                    mark = OPEN;
+                    path.push_back(Frame{ std::move(dependency), 0 });
+                }
+            }
+        }
+        return order;
+    }
+
     std::shared_ptr<TaskManager> taskManager;      // Task execution manager
     std::shared_ptr<ResourceManager> resourceManager;  // Resource management for I/O, memory, etc.
     std::shared_ptr<IOHandler> ioHandler;          // Input/output handler
     RuntimeState currentState;                     // Current runtime state
 };
 
+// The thread-per-task manager TaskManager replaced, minus its logging: one
+// std::thread per task, refusal once maxThreads are live, and a thread list
+// that waitForTasks joins but never shrinks.
+class LegacyTaskManager {
+public:
+    explicit LegacyTaskManager(int maxThreads) : maxThreads(maxThreads), activeThreads(0) {}
+
+    bool startTask(std::function<void()> work) {
+        if (activeThreads >= maxThreads) return false;
+        activeThreads++;
+        threads.emplace_back([this, work] {
+            work();
+            activeThreads--;
+        });
+        return true;
+    }
+
+    void waitForTasks() {
+        for (auto& thread : threads) {
+            if (thread.joinable()) thread.join();
+        }
+    }
+
+private:
+    int maxThreads;
+    std::atomic<int> activeThreads;
+    std::vector<std::thread> threads;
+};
+
+// Tiny tasks (one relaxed increment each) through the pool and through the
+// legacy manager. The legacy manager drops what it cannot start, so it is
+// measured twice: submitting everything blindly, and joining and retrying on
+// refusal, which is the only way to get all of its tasks run. Spawning a
+// thread per task is slow enough that the retry run uses tasks / 100.
+static int runTaskBenchmark(size_t tasks) {
+    using Clock = std::chrono::steady_clock;
+    std::atomic<size_t> ran{ 0 };
+    auto tiny = [&ran] { ran.fetch_add(1, std::memory_order_relaxed); };
+
+    {
+        TaskManager manager(MAX_RUNTIME_THREADS);
+        const auto start = Clock::now();
+        for (size_t i = 0; i < tasks; ++i) manager.submit(std::string(), tiny);
+        manager.waitForTasks();
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        std::cout << "[BENCH] pool, " << manager.workerCount() << " workers: " << ran.load() << "/" << tasks
+                  << " tasks ran, " << elapsed.count() / tasks << " ns/task" << std::endl;
+    }
+
+    ran = 0;
+    {
+        LegacyTaskManager legacy(MAX_RUNTIME_THREADS);
+        const auto start = Clock::now();
+        for (size_t i = 0; i < tasks; ++i) legacy.startTask(tiny);
+        legacy.waitForTasks();
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        std::cout << "[BENCH] legacy, drop on refusal: " << ran.load() << "/" << tasks << " tasks ran, "
+                  << tasks - ran.load() << " dropped, " << elapsed.count() / tasks << " ns/task submitted" << std::endl;
+    }
+
+    ran = 0;
+    const size_t retried = std::max<size_t>(1, tasks / 100);
+    {
+        LegacyTaskManager legacy(MAX_RUNTIME_THREADS);
+        const auto start = Clock::now();
+        for (size_t i = 0; i < retried; ++i) {
+            while (!legacy.startTask(tiny)) legacy.waitForTasks();
+        }
+        legacy.waitForTasks();
+        const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+        std::cout << "[BENCH] legacy, join and retry: " << ran.load() << "/" << retried << " tasks ran, "
+                  << elapsed.count() / retried << " ns/task" << std::endl;
+    }
+    return 0;
+}
+
+// A multi-stage job: four branches of three stages with uneven lengths,
+// joined by a final stage. Run in waves (each stage level waits for the
+// slowest branch), as executeTask alone allowed, and then as one graph.
+static void runPipelineBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    const int branches = 4;
+    const int stages = 3;
+    auto stage = [](int branch, int level) {
+        const int millis = ((branch + level) % branches + 1) * 5;
+        return [millis] { std::this_thread::sleep_for(std::chrono::milliseconds(millis)); };
+    };
+
+    Runtime runtime;
+    runtime.initialize();
+
+    const auto waves = Clock::now();
+    for (int level = 0; level < stages; ++level) {
+        std::vector<std::shared_ptr<Task>> wave;
+        for (int branch = 0; branch < branches; ++branch) {
+            wave.push_back(std::make_shared<Task>("wave", stage(branch, level)));
+            runtime.executeTask(wave.back());
+        }
+        for (const auto& task : wave) task->wait();
+    }
+    auto last = std::make_shared<Task>("join", stage(0, 0));
+    runtime.executeTask(last);
+    last->wait();
+    const std::chrono::duration<double, std::milli> waveMs = Clock::now() - waves;
+
+    const auto graph = Clock::now();
+    auto join = std::make_shared<Task>("join", stage(0, 0));
+    for (int branch = 0; branch < branches; ++branch) {
+        std::shared_ptr<Task> previous;
+        for (int level = 0; level < stages; ++level) {
+            auto next = std::make_shared<Task>("stage", stage(branch, level));
+            if (previous) next->dependsOn(previous);
+            previous = next;
+        }
+        join->dependsOn(previous);
+    }
+    runtime.executeTask(join);
+    join->wait();
+    const std::chrono::duration<double, std::milli> graphMs = Clock::now() - graph;
+
+    std::cout << "[BENCH] " << branches << "x" << stages << " stage job: waves " << waveMs.count()
+              << " ms, dependency graph " << graphMs.count() << " ms" << std::endl;
+}
+
+// Cost of polling a token, and how far past their deadline spinning tasks
+// run before they notice the scheduler has cancelled them.
+static void runDeadlineBenchmark() {
+    using Clock = std::chrono::steady_clock;
+    execue::CancellationSource source;
+    const execue::CancellationToken token = source.token();
+    const uint64_t polls = 100000000;
+    uint64_t live = 0;
+    const auto polling = Clock::now();
+    for (uint64_t i = 0; i < polls; ++i) live += !token.cancelled();
+    const std::chrono::duration<double, std::nano> pollNs = Clock::now() - polling;
+
+    const int spinners = 8;
+    const auto timeout = std::chrono::milliseconds(20);
+    std::vector<double> overrun(spinners);
+    TaskManager manager(MAX_RUNTIME_THREADS);
+    for (int i = 0; i < spinners; ++i) {
+        auto task = std::make_shared<Task>("spinner");
+        task->timeout = timeout;
+        task->work = [token = task->token(), timeout, &slot = overrun[i]] {
+            const auto start = Clock::now();
+            while (!token.cancelled()) {
+            }
+            const std::chrono::duration<double, std::milli> late = Clock::now() - start - timeout;
+            slot = late.count();
+        };
+        manager.startTask(task);
+    }
+    manager.waitForTasks();
+    const TaskCounters counts = manager.counters();
+    double worst = 0;
+    double total = 0;
+    for (double late : overrun) {
+        worst = std::max(worst, late);
+        total += late;
+    }
+
+    std::cout << "[BENCH] token poll: " << pollNs.count() / polls << " ns (" << live << " live)" << std::endl;
+    std::cout << "[BENCH] " << spinners << " spinning tasks, " << timeout.count() << " ms timeout: " << counts.timedOut
+              << " timed out, " << counts.completed << " completed; overrun mean " << total / spinners
+              << " ms, worst " << worst << " ms" << std::endl;
+}
+
 // Main execution flow for the runtime system
-int main() {
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strncmp(argv[1], "--bench", 7) == 0) {
+        const long tasks = argv[1][7] == '=' ? std::atol(argv[1] + 8) : 1000000;
+        const int status = runTaskBenchmark(static_cast<size_t>(std::max(1L, tasks)));
+        runPipelineBenchmark();
+        runDeadlineBenchmark();
+        return status;
+    }
+
     try {
         Runtime runtime;
         runtime.initialize();
@@ -181,15 +792,34 @@ int main() {
         runtime.handleOutput("Starting task execution...");
 
         // Simulate task execution
-        auto taskA = std::make_shared<Task>("Task A");
+        auto taskA = std::make_shared<Task>("Task A", [] {
+            std::cout << "Starting task: Task A" << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5000)); // Simulate task execution time
+            std::cout << "Task Task A completed." << std::endl;
+        });
         runtime.executeTask(taskA);
 
+        // A task that never finishes by itself; its deadline stops it
+        auto taskB = std::make_shared<Task>("Task B");
+        taskB->timeout = std::chrono::milliseconds(1000);
+        taskB->work = [token = taskB->token()] {
+            std::cout << "Starting task: Task B" << std::endl;
+            while (!token.cancelled()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            std::cout << "Task Task B stopped: " << execue::cancelReasonName(token.reason()) << std::endl;
+        };
+        runtime.executeTask(taskB);
+
         // Simulate resource allocation and deallocation
         runtime.simulateResourceAllocation();
 
         // Wait for task completion
         runtime.waitForCompletion();
 
+        const TaskCounters counts = runtime.taskCounters();
+        std::cout << "Tasks: " << counts.completed << " completed, " << counts.failed << " failed, "
+                  << counts.cancelled << " cancelled (" << counts.timedOut << " timed out)" << std::endl;
         std::cout << "Runtime has completed all tasks." << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "Critical Runtime Error: " << e.what() << std::endl;
@@ -9,6 +9,9 @@
 #include <stdexcept>
 #include <functional>
 
+#include "src/io/output_sink.h"
+#include "src/runtime/cancellation.h"
+
 // -- Execue Core System Namespace
 namespace Execue {
 
@@ -29,7 +32,16 @@ namespace Execue {
     class Logger {
     public:
         static void log(const std::string& message) {
-            std::cout << "[EXECUE]: " << message << std::endl;
+            execue::OutputSink::standard().line("[EXECUE]: ", message);
+        }
+
+        // Lets hosts batch log output; see execue::SinkMode.
+        static void setMode(execue::SinkMode mode) {
+            execue::OutputSink::standard().setMode(mode);
+        }
+
+        static void flush() {
+            execue::OutputSink::standard().flush();
         }
     };
 
@@ -85,8 +97,14 @@ namespace Execue {
             tasks.emplace_back(id, fn);
         }
 
-        void executeAll() {
+        // Checks `token` before each task; the remaining tasks are skipped
+        // once it is cancelled.
+        void executeAll(const execue::CancellationToken& token = execue::CancellationToken()) {
             for (auto& task : tasks) {
+                if (token.cancelled()) {
+                    Logger::log(std::string("Task run stopped: ") + execue::cancelReasonName(token.reason()));
+                    return;
+                }
                 task.run();
             }
         }
@@ -98,12 +116,14 @@ namespace Execue {
     // === Stream Execution Handler ===
     class ExecutionStream {
     public:
-        void open(const std::string& source) {
+        // A pulse loop polls isActive(), so cancelling `token` ends the stream.
+        void open(const std::string& source, execue::CancellationToken token = execue::CancellationToken()) {
             Logger::log("Stream opened from: " + source);
+            cancellation = std::move(token);
             active = true;
         }
 
-        bool isActive() const { return active; }
+        bool isActive() const { return active && !cancellation.cancelled(); }
 
         std::string pulse() {
             return "stream-pulse";
@@ -111,6 +131,7 @@ namespace Execue {
 
     private:
         bool active = false;
+        execue::CancellationToken cancellation;
     };
 
     // === Compile Target Metadata ===
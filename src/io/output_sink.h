@@ -0,0 +1,150 @@
+#pragma once
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace execue {
+    // DIRECT writes and flushes every record, like `<< std::endl`. BUFFERED
+    // collects records until flush(), the size threshold or destruction. BINARY
+    // buffers the same way but emits tagged records instead of text lines.
+    enum class SinkMode { DIRECT, BUFFERED, BINARY };
+
+    // Binary record layout: a one-byte tag followed by a little-endian payload.
+    //   VALUE: int32 value
+    //   TEXT:  uint32 byte count, then the bytes (no newline)
+    // Text labels are dropped from VALUE records; readers know the producer.
+    enum class RecordTag : uint8_t { VALUE = 1, TEXT = 2 };
+
+    // Output channel for VM PRINT, the runtime Logger and the renderer. Records
+    // are only ever written to the stream whole, so sinks on different threads
+    // sharing one stream interleave by record (or by flushed batch), never
+    // mid-line. A sink itself is not thread-safe: use one per thread. The
+    // exceptions are standard() and standardError(), which lock around every
+    // call.
+    class OutputSink {
+    public:
+        static constexpr size_t kDefaultThreshold = 64 * 1024;
+
+        explicit OutputSink(std::ostream& stream, SinkMode mode = SinkMode::DIRECT,
+                            size_t threshold = kDefaultThreshold)
+            : out(&stream), mode_(mode), threshold(threshold) {
+            buffer.reserve(mode == SinkMode::DIRECT ? 64 : threshold);
+        }
+
+        OutputSink(const OutputSink&) = delete;
+        OutputSink& operator=(const OutputSink&) = delete;
+
+        ~OutputSink() {
+            flush();
+        }
+
+        SinkMode mode() const {
+            const auto guard = exclusive();
+            return mode_;
+        }
+
+        // Flushes what the previous mode buffered before switching.
+        void setMode(SinkMode mode) {
+            const auto guard = exclusive();
+            drain();
+            mode_ = mode;
+        }
+
+        void setThreshold(size_t bytes) {
+            const auto guard = exclusive();
+            threshold = bytes;
+            if (buffer.size() >= threshold) drain();
+        }
+
+        // "<label><value>\n", or a VALUE record.
+        void value(std::string_view label, int32_t number) {
+            const auto guard = exclusive();
+            if (mode_ == SinkMode::BINARY) {
+                buffer.push_back(static_cast<char>(RecordTag::VALUE));
+                appendLittleEndian(static_cast<uint32_t>(number));
+            } else {
+                char digits[16];
+                const auto end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+                buffer.append(label);
+                buffer.append(digits, end);
+                buffer.push_back('\n');
+            }
+            commit();
+        }
+
+        // "<prefix><text>\n", or one TEXT record holding both.
+        void line(std::string_view prefix, std::string_view text) {
+            const auto guard = exclusive();
+            if (mode_ == SinkMode::BINARY) {
+                buffer.push_back(static_cast<char>(RecordTag::TEXT));
+                appendLittleEndian(static_cast<uint32_t>(prefix.size() + text.size()));
+                buffer.append(prefix);
+                buffer.append(text);
+            } else {
+                buffer.append(prefix);
+                buffer.append(text);
+                buffer.push_back('\n');
+            }
+            commit();
+        }
+
+        void line(std::string_view text) {
+            line(std::string_view(), text);
+        }
+
+        void flush() {
+            const auto guard = exclusive();
+            drain();
+        }
+
+        // Process-wide sinks on stdout and stderr, DIRECT until reconfigured.
+        // Any thread may use them; each call holds the sink's lock.
+        static OutputSink& standard() {
+            static OutputSink sink(std::cout, Shared{});
+            return sink;
+        }
+
+        static OutputSink& standardError() {
+            static OutputSink sink(std::cerr, Shared{});
+            return sink;
+        }
+
+    private:
+        struct Shared {};
+
+        OutputSink(std::ostream& stream, Shared) : OutputSink(stream) {
+            shared = true;
+        }
+
+        std::ostream* out;
+        SinkMode mode_;
+        size_t threshold;
+        std::string buffer;
+        bool shared = false;
+        mutable std::mutex lock;
+
+        // Per-thread sinks skip the lock entirely.
+        std::unique_lock<std::mutex> exclusive() const {
+            return shared ? std::unique_lock<std::mutex>(lock) : std::unique_lock<std::mutex>();
+        }
+
+        void drain() {
+            if (buffer.empty()) return;
+            out->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            out->flush();
+            buffer.clear();
+        }
+
+        void appendLittleEndian(uint32_t word) {
+            for (int shift = 0; shift < 32; shift += 8) buffer.push_back(static_cast<char>((word >> shift) & 0xFF));
+        }
+
+        void commit() {
+            if (mode_ == SinkMode::DIRECT || buffer.size() >= threshold) drain();
+        }
+    };
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace execue {
+    // How a memory checks addresses. Chosen per program at load time: programs
+    // whose every address was verified run UNCHECKED; the rest run under one of
+    // the checked policies.
+    enum class MemoryAccess { CHECKED, ERROR_REGISTER, UNCHECKED };
+
+    inline const char* memoryAccessName(MemoryAccess access) {
+        switch (access) {
+            case MemoryAccess::CHECKED: return "checked";
+            case MemoryAccess::ERROR_REGISTER: return "error-register";
+            case MemoryAccess::UNCHECKED: return "unchecked";
+        }
+        return "unknown";
+    }
+
+    // Policies are stateless; admit() returns whether the access may proceed.
+    // A refused access is skipped (reads yield 0) and raises `fault`.
+
+    // Throws std::out_of_range on a bad address.
+    struct CheckedAccess {
+        static constexpr MemoryAccess kind = MemoryAccess::CHECKED;
+        static constexpr bool records_faults = false;
+
+        static bool admit(size_t address, size_t limit, bool&) {
+            if (address >= limit) {
+                throw std::out_of_range("Memory address " + std::to_string(address) + " out of range");
+            }
+            return true;
+        }
+    };
+
+    // Refuses a bad address and raises the owner's error register.
+    struct ErrorRegisterAccess {
+        static constexpr MemoryAccess kind = MemoryAccess::ERROR_REGISTER;
+        static constexpr bool records_faults = true;
+
+        static bool admit(size_t address, size_t limit, bool& fault) {
+            if (address >= limit) {
+                fault = true;
+                return false;
+            }
+            return true;
+        }
+    };
+
+    // No check at all: only for programs whose addresses were verified.
+    struct UncheckedAccess {
+        static constexpr MemoryAccess kind = MemoryAccess::UNCHECKED;
+        static constexpr bool records_faults = false;
+
+        static bool admit(size_t, size_t, bool&) {
+            return true;
+        }
+    };
+}
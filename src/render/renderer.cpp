@@ -1,12 +1,13 @@
-#include <iostream>
 #include <string>
 
+#include "io/output_sink.h"
+
 namespace execue {
     void renderResult(const std::string& output) {
-        std::cout << "[Rendered Execue Output] >>> " << output << std::endl;
+        OutputSink::standard().line("[Rendered Execue Output] >>> ", output);
     }
 
     void renderError(const std::string& err) {
-        std::cerr << "[Execue ERROR] !!! " << err << std::endl;
+        OutputSink::standardError().line("[Execue ERROR] !!! ", err);
     }
 }
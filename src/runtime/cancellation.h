@@ -0,0 +1,134 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace execue {
+    enum class CancelReason : uint8_t { NONE, REQUESTED, DEADLINE };
+
+    inline const char* cancelReasonName(CancelReason reason) {
+        switch (reason) {
+            case CancelReason::NONE: return "none";
+            case CancelReason::REQUESTED: return "cancelled";
+            case CancelReason::DEADLINE: return "deadline exceeded";
+        }
+        return "unknown";
+    }
+
+    // Thrown by CancellationToken::throwIfCancelled.
+    class OperationCancelled : public std::runtime_error {
+    public:
+        explicit OperationCancelled(CancelReason reason)
+            : std::runtime_error(cancelReasonName(reason)), reason(reason) {}
+
+        CancelReason reason;
+    };
+
+    // Shared by a source and its tokens; freed with the last of them.
+    struct CancellationState {
+        std::atomic<CancelReason> reason{ CancelReason::NONE };
+        std::atomic<uint32_t> references{ 1 };
+
+        static CancellationState* retain(CancellationState* state) {
+            if (state) state->references.fetch_add(1, std::memory_order_relaxed);
+            return state;
+        }
+
+        static void release(CancellationState* state) {
+            if (state && state->references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete state;
+        }
+    };
+
+    // Read side of a cancellation, handed to whatever does the work. Polling
+    // is one relaxed load, cheap enough for every interpreter slice or loop
+    // iteration; cancellation is cooperative and only takes effect where
+    // someone polls. A default-constructed token is never cancelled.
+    class CancellationToken {
+    public:
+        CancellationToken() = default;
+
+        CancellationToken(const CancellationToken& other) : state(CancellationState::retain(other.state)) {}
+
+        CancellationToken(CancellationToken&& other) noexcept : state(std::exchange(other.state, nullptr)) {}
+
+        CancellationToken& operator=(CancellationToken other) noexcept {
+            std::swap(state, other.state);
+            return *this;
+        }
+
+        ~CancellationToken() {
+            CancellationState::release(state);
+        }
+
+        bool cancelled() const {
+            return state && state->reason.load(std::memory_order_relaxed) != CancelReason::NONE;
+        }
+
+        CancelReason reason() const {
+            return state ? state->reason.load(std::memory_order_relaxed) : CancelReason::NONE;
+        }
+
+        // False for a default token: polling it can be skipped altogether.
+        bool cancellable() const {
+            return state != nullptr;
+        }
+
+        void throwIfCancelled() const {
+            if (cancelled()) throw OperationCancelled(reason());
+        }
+
+    private:
+        friend class CancellationSource;
+
+        explicit CancellationToken(CancellationState* adopted) : state(adopted) {}
+
+        CancellationState* state = nullptr;
+    };
+
+    // Write side, kept by whoever may cancel: the task's owner, or a deadline
+    // scheduler. The first cancel() wins and fixes the reason. The shared
+    // state is only allocated once a token is handed out or cancel() is
+    // called, so sources that are never used cost nothing.
+    class CancellationSource {
+    public:
+        CancellationSource() = default;
+        CancellationSource(const CancellationSource&) = delete;
+        CancellationSource& operator=(const CancellationSource&) = delete;
+
+        ~CancellationSource() {
+            CancellationState::release(state.load(std::memory_order_acquire));
+        }
+
+        // Returns whether this call was the one that cancelled.
+        bool cancel(CancelReason reason = CancelReason::REQUESTED) {
+            CancelReason expected = CancelReason::NONE;
+            return shared()->reason.compare_exchange_strong(expected, reason);
+        }
+
+        bool cancelled() const {
+            return reason() != CancelReason::NONE;
+        }
+
+        CancelReason reason() const {
+            const CancellationState* current = state.load(std::memory_order_acquire);
+            return current ? current->reason.load(std::memory_order_relaxed) : CancelReason::NONE;
+        }
+
+        CancellationToken token() const {
+            return CancellationToken(CancellationState::retain(shared()));
+        }
+
+    private:
+        CancellationState* shared() const {
+            CancellationState* current = state.load(std::memory_order_acquire);
+            if (current) return current;
+            CancellationState* created = new CancellationState();
+            if (state.compare_exchange_strong(current, created, std::memory_order_acq_rel)) return created;
+            delete created;
+            return current;
+        }
+
+        mutable std::atomic<CancellationState*> state{ nullptr };
+    };
+}